@@ -55,12 +55,6 @@
 #include <string>
 #include <cmath>
 
-const int kMaxHits       = 30000; ///< maximum number of hits
-//const int kMaxAuxDets = 100;
-//const unsigned short kMaxTkIDs = 100;
-const int kMaxCHits      = 1000;  ///< maximum number of CRT hits
-const int kMaxNCtrks     = 10;
-
 const int MAX_INT = std::numeric_limits<int>::max();
 const long int TIME_CORRECTION = (long int) std::numeric_limits<int>::max() * 2;
 
@@ -109,6 +103,20 @@ private:
 
   void ResetVars();
 
+  /// Accumulates the strips of one CRT face and orientation for the simple CRT track maker
+  struct CRTStripAccumulator {
+    int   nhits  = 0;   ///< Number of strips accumulated
+    float time   = 0;   ///< Time of the selected strip
+    float pos    = 0;   ///< Position of the selected strip
+    float module = -1;  ///< Module of the selected strip
+    float adc    = 0;   ///< Accumulated ADC
+
+    void Add(double strip_time, double strip_adc, double strip_pos, int strip_module);
+  };
+
+  /// Makes the simple CRT tracks from the CRT strips in the tree variables
+  void MakeCRTTracks();
+
   opdet::sbndPDMapAlg _pd_map;
 
   TTree* fTree;
@@ -120,68 +128,68 @@ private:
   int _t0;                             ///< The t0
 
   int    _nhits;                       ///< Number of reco hits in the event
-  int    _hit_cryostat[kMaxHits];      ///< Cryostat where the hit belongs to
-  int    _hit_tpc[kMaxHits];           ///< TPC where the hit belongs to
-  int    _hit_plane[kMaxHits];         ///< Plane where the hit belongs to
-  int    _hit_wire[kMaxHits];          ///< Wire where the hit belongs to
-  int    _hit_channel[kMaxHits];       ///< Channel where the hit belongs to
-  double _hit_peakT[kMaxHits];         ///< Hit peak time
-  double _hit_charge[kMaxHits];        ///< Hit charge
-  double _hit_ph[kMaxHits];            ///< Hit ph?
-  double _hit_width[kMaxHits];         ///< Hit width
+  std::vector<int> _hit_cryostat;         ///< Cryostat where the hit belongs to
+  std::vector<int> _hit_tpc;              ///< TPC where the hit belongs to
+  std::vector<int> _hit_plane;            ///< Plane where the hit belongs to
+  std::vector<int> _hit_wire;             ///< Wire where the hit belongs to
+  std::vector<int> _hit_channel;          ///< Channel where the hit belongs to
+  std::vector<double> _hit_peakT;         ///< Hit peak time
+  std::vector<double> _hit_charge;        ///< Hit charge
+  std::vector<double> _hit_ph;            ///< Hit ph?
+  std::vector<double> _hit_width;         ///< Hit width
 
   int _nstrips;                        ///< Number of CRT strips
-  int _crt_plane[kMaxCHits];           ///< CRT plane
-  int _crt_module[kMaxCHits];          ///< CRT module
-  int _crt_strip[kMaxCHits];           ///< CRT strip
-  int _crt_orient[kMaxCHits];          ///< CRT orientation (0 for y (horizontal) and 1 for x (vertical))
-  double _crt_time[kMaxCHits];         ///< CRT time
-  double _crt_adc[kMaxCHits];          ///< CRT adc
-  double _crt_pos[kMaxCHits];          ///< CRT position
+  std::vector<int> _crt_plane;            ///< CRT plane
+  std::vector<int> _crt_module;           ///< CRT module
+  std::vector<int> _crt_strip;            ///< CRT strip
+  std::vector<int> _crt_orient;           ///< CRT orientation (0 for y (horizontal) and 1 for x (vertical))
+  std::vector<double> _crt_time;          ///< CRT time
+  std::vector<double> _crt_adc;           ///< CRT adc
+  std::vector<double> _crt_pos;           ///< CRT position
 
   int _nctrks;                         ///< Number of created CRT tracks
-  double _ctrk_x1[kMaxNCtrks];         ///< CRT track x1
-  double _ctrk_y1[kMaxNCtrks];         ///< CRT track y1
-  double _ctrk_z1[kMaxNCtrks];         ///< CRT track z1
-  double _ctrk_t1[kMaxNCtrks];         ///< CRT track t1
-  double _ctrk_adc1[kMaxNCtrks];       ///< CRT track adc1
-  int _ctrk_mod1x[kMaxNCtrks];         ///< CRT track mod2x
-  double _ctrk_x2[kMaxNCtrks];         ///< CRT track x2
-  double _ctrk_y2[kMaxNCtrks];         ///< CRT track y2
-  double _ctrk_z2[kMaxNCtrks];         ///< CRT track z2
-  double _ctrk_t2[kMaxNCtrks];         ///< CRT track t2
-  double _ctrk_adc2[kMaxNCtrks];       ///< CRT track adc2
-  int _ctrk_mod2x[kMaxNCtrks];         ///< CRT track mod2x
+  std::vector<double> _ctrk_x1;           ///< CRT track x1
+  std::vector<double> _ctrk_y1;           ///< CRT track y1
+  std::vector<double> _ctrk_z1;           ///< CRT track z1
+  std::vector<double> _ctrk_t1;           ///< CRT track t1
+  std::vector<double> _ctrk_adc1;         ///< CRT track adc1
+  std::vector<int> _ctrk_mod1x;           ///< CRT track mod2x
+  std::vector<double> _ctrk_x2;           ///< CRT track x2
+  std::vector<double> _ctrk_y2;           ///< CRT track y2
+  std::vector<double> _ctrk_z2;           ///< CRT track z2
+  std::vector<double> _ctrk_t2;           ///< CRT track t2
+  std::vector<double> _ctrk_adc2;         ///< CRT track adc2
+  std::vector<int> _ctrk_mod2x;           ///< CRT track mod2x
   
   int _nchits;                         ///< Number of CRT hits
-  double _chit_x[kMaxCHits];           ///< CRT hit x
-  double _chit_y[kMaxCHits];           ///< CRT hit y
-  double _chit_z[kMaxCHits];           ///< CRT hit z
-  double _chit_time[kMaxCHits];        ///< CRT hit time
-  // double _chit_adc[kMaxCHits];         ///< CRT hit adc
-  int _chit_plane[kMaxCHits];          ///< CRT hit plane
+  std::vector<double> _chit_x;            ///< CRT hit x
+  std::vector<double> _chit_y;            ///< CRT hit y
+  std::vector<double> _chit_z;            ///< CRT hit z
+  std::vector<double> _chit_time;         ///< CRT hit time
+  // std::vector<double> _chit_adc;       ///< CRT hit adc
+  std::vector<int> _chit_plane;           ///< CRT hit plane
 
   int _ncts;                           ///< Number of CRT tracks
-  double _ct_time[kMaxNCtrks];         ///< CRT track time
-  double _ct_pes[kMaxNCtrks];          ///< CRT track PEs
-  double _ct_x1[kMaxNCtrks];           ///< CRT track x1
-  double _ct_y1[kMaxNCtrks];           ///< CRT track y1
-  double _ct_z1[kMaxNCtrks];           ///< CRT track z1
-  double _ct_x2[kMaxNCtrks];           ///< CRT track x2
-  double _ct_y2[kMaxNCtrks];           ///< CRT track y2
-  double _ct_z2[kMaxNCtrks];           ///< CRT track z2
+  std::vector<double> _ct_time;           ///< CRT track time
+  std::vector<double> _ct_pes;            ///< CRT track PEs
+  std::vector<double> _ct_x1;             ///< CRT track x1
+  std::vector<double> _ct_y1;             ///< CRT track y1
+  std::vector<double> _ct_z1;             ///< CRT track z1
+  std::vector<double> _ct_x2;             ///< CRT track x2
+  std::vector<double> _ct_y2;             ///< CRT track y2
+  std::vector<double> _ct_z2;             ///< CRT track z2
 
   int _nophits;                        ///< Number of Optical Hits
-  int _ophit_opch[kMaxHits];           ///< OpChannel of the optical hit
-  int _ophit_opdet[kMaxHits];          ///< OpDet of the optical hit
-  double _ophit_peakT[kMaxHits];       ///< Peak time of the optical hit
-  double _ophit_width[kMaxHits];       ///< Width of the optical hit
-  double _ophit_area[kMaxHits];        ///< Area of the optical hit
-  double _ophit_amplitude[kMaxHits];   ///< Amplitude of the optical hit
-  double _ophit_pe[kMaxHits];          ///< PEs of the optical hit
-  double _ophit_opdet_x[kMaxHits];     ///< OpDet X coordinate of the optical hit
-  double _ophit_opdet_y[kMaxHits];     ///< OpDet Y coordinate of the optical hit
-  double _ophit_opdet_z[kMaxHits];     ///< OpDet Z coordinate of the optical hit
+  std::vector<int> _ophit_opch;           ///< OpChannel of the optical hit
+  std::vector<int> _ophit_opdet;          ///< OpDet of the optical hit
+  std::vector<double> _ophit_peakT;       ///< Peak time of the optical hit
+  std::vector<double> _ophit_width;       ///< Width of the optical hit
+  std::vector<double> _ophit_area;        ///< Area of the optical hit
+  std::vector<double> _ophit_amplitude;   ///< Amplitude of the optical hit
+  std::vector<double> _ophit_pe;          ///< PEs of the optical hit
+  std::vector<double> _ophit_opdet_x;     ///< OpDet X coordinate of the optical hit
+  std::vector<double> _ophit_opdet_y;     ///< OpDet Y coordinate of the optical hit
+  std::vector<double> _ophit_opdet_z;     ///< OpDet Z coordinate of the optical hit
 
 
   std::string fHitsModuleLabel;     ///< Label for Hit dataproduct (to be set via fcl)
@@ -282,11 +290,15 @@ void Hitdumper::analyze(const art::Event& evt)
     _nhits = 0;
   }
 
-  if (_nhits > kMaxHits) {
-    std::cout << "Available hits are " << _nhits << ", which is above the maximum number allowed to store." << std::endl;
-    std::cout << "Will only store " << kMaxHits << "hits." << std::endl;
-    _nhits = kMaxHits;
-  }
+  _hit_cryostat.resize(_nhits);
+  _hit_tpc.resize(_nhits);
+  _hit_plane.resize(_nhits);
+  _hit_wire.resize(_nhits);
+  _hit_channel.resize(_nhits);
+  _hit_peakT.resize(_nhits);
+  _hit_charge.resize(_nhits);
+  _hit_ph.resize(_nhits);
+  _hit_width.resize(_nhits);
   for (int i = 0; i<_nhits; ++i){
     geo::WireID wireid = hitlist[i]->WireID();
     _hit_cryostat[i]    = wireid.Cryostat;
@@ -316,10 +328,8 @@ void Hitdumper::analyze(const art::Event& evt)
     std::cout << "Failed to get sbnd::crt::CRTData data product." << std::endl;
   }
   
-  int ns = 0;
-  if (_nstr > kMaxCHits) _nstr = kMaxCHits;
   // strips are always in pairs, one entry for each sipm (2 sipms per strip) 
-  for (int i = 0; i < _nstr; i += 2){
+  for (int i = 0; i + 1 < _nstr; i += 2){
     uint32_t chan = striplist[i]->Channel();
 
     //    std::pair<std::string,unsigned> tagger = CRTHitRecoAlg::ChannelToTagger(chan);
@@ -357,164 +367,20 @@ void Hitdumper::analyze(const art::Event& evt)
         //
         std::string name = fGeometryService->AuxDet(module).TotalVolume()->GetName();
         TVector3 center = fAuxDetGeoCore->AuxDetChannelToPosition(2*strip, name);
-        _crt_plane[ns]  = ip;
-        _crt_module[ns] = module;
-        _crt_strip[ns]  = strip;
-        _crt_orient[ns] = tagger.second;
-        _crt_time[ns]   = ctime;
-        _crt_adc[ns]    = adc1 + adc2 - 127.2; // -127.2/131.9 correct for gain and 2*ped to get pe
-        _crt_pos[ns]    = center.Y();
-        if (tagger.second==1) _crt_pos[ns] = center.X();
-        ns++;
+        _crt_plane.push_back(ip);
+        _crt_module.push_back(module);
+        _crt_strip.push_back(strip);
+        _crt_orient.push_back(tagger.second);
+        _crt_time.push_back(ctime);
+        _crt_adc.push_back(adc1 + adc2 - 127.2); // -127.2/131.9 correct for gain and 2*ped to get pe
+        _crt_pos.push_back(tagger.second==1 ? center.X() : center.Y());
       }
     }
   }
-  _nstrips = ns;
+  _nstrips = _crt_time.size();
 
   _nctrks = 0;
-  if (fmakeCRTtracks) {
-    int ntr = 0;
-    int iflag[1000] = {0};
-    for (int i = 0; i < (ns - 1); ++i) {
-      if (iflag[i] == 0) {
-        iflag[i] = 1;
-        float plane1x = 0, plane2x = 0;
-        float plane1y = 0, plane2y = 0;
-        float plane1tx = 0, plane2tx = 0;
-        float plane1ty = 0, plane2ty = 0;
-        float plane1xm = -1, plane2xm = -1;
-        float plane1ym = -1, plane2ym = -1;
-        int  nh1x = 0, nh2x = 0;
-        int  nh1y = 0, nh2y = 0;
-        float adc1x = 0, adc2x = 0;
-        float adc1y = 0, adc2y = 0;
-        if (_crt_plane[i] == kFaceFront) { // 1
-          if (_crt_orient[i] == kCRTVertical && _crt_adc[i] > 500) { // < 500 hardcoded
-            if (nh1x == 0 || (_crt_module[i] == plane1xm)) {
-              nh1x++;
-              if (_crt_adc[i] > adc1x) {
-                plane1tx = _crt_time[i];
-                adc1x += _crt_adc[i];
-                plane1x = _crt_pos[i];
-                plane1xm = _crt_module[i];
-              }
-            }
-          }
-          else if (_crt_orient[i]==kCRTHorizontal && _crt_adc[i]>500) { // < 500 hardcoded
-            if (nh1y==0 || (_crt_module[i]==plane1ym)) {
-              nh1y++; 
-              if (_crt_adc[i]>adc1y) {
-                plane1ty=_crt_time[i];
-                adc1y+=_crt_adc[i];
-                plane1y=_crt_pos[i];
-                plane1ym=_crt_module[i];
-              }
-            }
-          }
-        }
-        else {
-          if (_crt_orient[i]==kCRTVertical && _crt_adc[i]>500) { // < 500 hardcoded
-            if (nh2x==0 ||  (_crt_module[i]==plane2xm)) { 
-              nh2x++;	  
-              if (_crt_adc[i]>adc2x) {
-                plane2tx=_crt_time[i]; 
-                adc2x+=_crt_adc[i];
-                plane2x=_crt_pos[i];
-                plane2xm=_crt_module[i];
-              }
-            }
-          }
-          else if (_crt_orient[i]==kCRTHorizontal && _crt_adc[i]>500) { // < 500 hardcoded
-            if (nh2y==0 ||  (_crt_module[i]==plane2ym)) {
-              nh2y++; 
-              if (_crt_adc[i]>adc2y) {
-                plane2ty=_crt_time[i];
-                adc2y+=_crt_adc[i];
-                plane2y=_crt_pos[i];
-                plane2ym=_crt_module[i];
-              }
-            }
-          }
-        }
-        for (int j=i+1;j<ns;++j) {
-          float tdiff = fabs(_crt_time[i]-_crt_time[j]);
-          if (tdiff<0.1) {
-            iflag[j]=1;
-            if (_crt_plane[j]==kFaceFront) {
-              if (_crt_orient[j]==kCRTVertical && _crt_adc[j]>1000) {
-                if (nh1x==0 ||  (_crt_module[j]==plane1xm)) {
-                  nh1x++;	  
-                  if (_crt_adc[j]>adc1x) {
-                    plane1tx=_crt_time[j];
-                    adc1x+=_crt_adc[j];
-                    plane1x=_crt_pos[j];
-                    plane1xm=_crt_module[j];
-                  }
-                }
-              }
-              else if (_crt_orient[j]==kCRTHorizontal && _crt_adc[j]>1000) {
-                if (nh1y==0 ||  (_crt_module[j]==plane1ym)) {
-                  nh1y++; 
-                  if (_crt_adc[j]>adc1y) {
-                    plane1ty=_crt_time[j];
-                    adc1y+=_crt_adc[j];
-                    plane1y=_crt_pos[j];
-                    plane1ym=_crt_module[j];
-                  }
-                }
-              }
-            }
-            else {
-              if (_crt_orient[j]==kCRTVertical && _crt_adc[j]>1000) {
-                if (nh2x==0 ||  (_crt_module[j]==plane2xm)) {
-                  nh2x++;	  
-                  if (_crt_adc[j]>adc2x) {
-                    plane2tx=_crt_time[j];
-                    adc2x+=_crt_adc[j];
-                    plane2x=_crt_pos[j];
-                    plane2xm=_crt_module[j];
-                  }
-                }
-              }
-              else if (_crt_orient[j]==kCRTHorizontal && _crt_adc[j]>1000) {
-                if (nh2y==0 ||  (_crt_module[j]==plane2ym)) {
-                  nh2y++; 
-                  if (_crt_adc[j]>adc2y) {
-                    plane2ty=_crt_time[j];
-                    adc2y+=_crt_adc[j];
-                    plane2y=_crt_pos[j];
-                    plane2ym=_crt_module[j];
-                  }
-                }
-              }
-            }
-          }
-	      } // look for hits at the same time as hit i
-	      if (nh1x>0 && nh1y>0 && nh2x>0 && nh2y>0 && adc1x<9000 && adc1y<9000 && adc2x<9000 && adc2y<9000) { 
-	      // make a track!
-          _ctrk_x1[ntr]=plane1x;
-          _ctrk_y1[ntr]=plane1y;
-          _ctrk_z1[ntr]=-239.95;
-          _ctrk_t1[ntr]=0.5*(plane1tx+plane1ty);
-          _ctrk_adc1[ntr]=adc1x+adc1y;
-          _ctrk_mod1x[ntr]=plane1xm;
-          _ctrk_x2[ntr]=plane2x;
-          _ctrk_y2[ntr]=plane2y;
-          _ctrk_z2[ntr]=656.25;
-          _ctrk_t2[ntr]=0.5*(plane2tx+plane2ty);
-          _ctrk_adc2[ntr]=adc2x+adc2y;
-          _ctrk_mod2x[ntr]=plane2xm;
-          ntr++;
-	        // std::cout << "track " << ntr << std::endl;
-	        // std::cout <<  "x y t adc: plane 1 " << plane1x << " " << plane1y << " " << 
-	        //   0.5*(plane1tx+plane1ty) << " " << adc1x << " " << adc1y << std::endl;
-	        // std::cout <<  "         : plane 2 " << plane2x << " " << plane2y << " " << 
-	        //   0.5*(plane2tx+plane2ty) << " " << adc2x << " " << adc2y << std::endl;
-        }
-      } // i is the first hit with this time
-    } // loop over hits      
-    _nctrks = ntr;
-  }  // end if make tracks
+  if (fmakeCRTtracks) MakeCRTTracks();
 
   //
   // CRT hits
@@ -526,18 +392,18 @@ void Hitdumper::analyze(const art::Event& evt)
     // std::vector< art::Ptr<crt::CRTData> > striplist;
     if (evt.getByLabel(fCRTHitModuleLabel, crtHitListHandle))  {
       art::fill_ptr_vector(chitlist, crtHitListHandle);
-      _nchits = hitlist.size();
+      _nchits = chitlist.size();
     }
     else {
       std::cout << "Failed to get sbnd::crt::CRTHit data product." << std::endl;
       _nchits = 0;
     }
 
-    if (_nchits > kMaxCHits) {
-      std::cout << "Available CRT hits are " << _nchits << ", which is above the maximum number allowed to store." << std::endl;
-      std::cout << "Will only store " << kMaxCHits << "CRT hits." << std::endl;
-      _nchits = kMaxCHits;
-    }
+    _chit_time.resize(_nchits);
+    _chit_x.resize(_nchits);
+    _chit_y.resize(_nchits);
+    _chit_z.resize(_nchits);
+    _chit_plane.resize(_nchits);
     //  std::cout << " number CRT hits " << nchits << std::endl;
     for (int i = 0; i < _nchits; ++i){
       int ip = kNotDefined;
@@ -571,7 +437,14 @@ void Hitdumper::analyze(const art::Event& evt)
     if (evt.getByLabel(fCRTTrackModuleLabel, crtTrackListHandle))  {
       art::fill_ptr_vector(ctrklist, crtTrackListHandle);
       _ncts = ctrklist.size();
-      if (_ncts > kMaxNCtrks) _ncts = kMaxNCtrks;
+      _ct_pes.resize(_ncts);
+      _ct_time.resize(_ncts);
+      _ct_x1.resize(_ncts);
+      _ct_y1.resize(_ncts);
+      _ct_z1.resize(_ncts);
+      _ct_x2.resize(_ncts);
+      _ct_y2.resize(_ncts);
+      _ct_z2.resize(_ncts);
       for (int i = 0; i < _ncts; ++i){
         _ct_pes[i] = ctrklist[i]->peshit;
         _ct_time[i] = ctrklist[i]->ts1_ns*0.001;
@@ -598,40 +471,113 @@ void Hitdumper::analyze(const art::Event& evt)
   std::vector<art::Ptr<recob::OpHit> > ophitlist;
   if (evt.getByLabel(fOpHitsModuleLabel, ophitListHandle)) {
     art::fill_ptr_vector(ophitlist, ophitListHandle);
-    _nophits = ophitlist.size();
   }
   else {
     std::cout << "Failed to get recob::OpHit data product." << std::endl;
-    _nophits = 0;
   }
 
-  if (_nophits > kMaxHits) {
-    std::cout << "Available optical hits are " << _nophits << ", which is above the maximum number allowed to store." << std::endl;
-    std::cout << "Will only store " << kMaxHits << " optical hits." << std::endl;
-    _nophits = kMaxHits;
-  }
-  int counter = 0;
-  for (int i = 0; i < _nophits; ++i) {
+  for (auto const& ophit : ophitlist) {
     // TODO: why only pmt_coated? ~icaza
-    if (!_pd_map.isPDType(ophitlist.at(i)->OpChannel(), "pmt_coated")) continue;
-    _ophit_opch[counter] = ophitlist.at(i)->OpChannel();
-    _ophit_opdet[counter] = fGeometryService->OpDetFromOpChannel(ophitlist.at(i)->OpChannel());
-    _ophit_peakT[counter] = ophitlist.at(i)->PeakTime();
-    _ophit_width[counter] = ophitlist.at(i)->Width();
-    _ophit_area[counter] = ophitlist.at(i)->Area();
-    _ophit_amplitude[counter] = ophitlist.at(i)->Amplitude();
-    _ophit_pe[counter] = ophitlist.at(i)->PE();
-    auto opdet_center = fGeometryService->OpDetGeoFromOpChannel(ophitlist.at(i)->OpChannel()).GetCenter();
-    _ophit_opdet_x[counter] = opdet_center.X();
-    _ophit_opdet_y[counter] = opdet_center.Y();
-    _ophit_opdet_z[counter] = opdet_center.Z();
-    counter++;
+    if (!_pd_map.isPDType(ophit->OpChannel(), "pmt_coated")) continue;
+    _ophit_opch.push_back(ophit->OpChannel());
+    _ophit_opdet.push_back(fGeometryService->OpDetFromOpChannel(ophit->OpChannel()));
+    _ophit_peakT.push_back(ophit->PeakTime());
+    _ophit_width.push_back(ophit->Width());
+    _ophit_area.push_back(ophit->Area());
+    _ophit_amplitude.push_back(ophit->Amplitude());
+    _ophit_pe.push_back(ophit->PE());
+    auto opdet_center = fGeometryService->OpDetGeoFromOpChannel(ophit->OpChannel()).GetCenter();
+    _ophit_opdet_x.push_back(opdet_center.X());
+    _ophit_opdet_y.push_back(opdet_center.Y());
+    _ophit_opdet_z.push_back(opdet_center.Z());
   }
+  _nophits = _ophit_opch.size();
 
   fTree->Fill();
 
 }
 
+void Hitdumper::CRTStripAccumulator::Add(double strip_time, double strip_adc, double strip_pos, int strip_module)
+{
+  if (nhits == 0 || strip_module == module) {
+    nhits++;
+    if (strip_adc > adc) {
+      time = strip_time;
+      adc += strip_adc;
+      pos = strip_pos;
+      module = strip_module;
+    }
+  }
+}
+
+void Hitdumper::MakeCRTTracks()
+{
+  // A strip seeds a track if no earlier seed has grouped it already, and the group is the seed
+  // plus every later strip within 0.1 us of it. The strips are indexed by time so that only the
+  // strips inside each window are visited instead of every pair.
+  const double window = 0.1;
+  const int ns = _nstrips;
+
+  std::vector<int> time_order(ns);
+  for (int i = 0; i < ns; ++i) time_order[i] = i;
+  std::sort(time_order.begin(), time_order.end(),
+            [this](int a, int b) { return _crt_time[a] < _crt_time[b]; });
+  std::vector<double> sorted_time(ns);
+  for (int i = 0; i < ns; ++i) sorted_time[i] = _crt_time[time_order[i]];
+
+  std::vector<bool> grouped(ns, false);
+  std::vector<int> group;
+  for (int i = 0; i < (ns - 1); ++i) {
+    if (grouped[i]) continue;
+    grouped[i] = true;
+
+    // accumulators per face (front, other) and orientation (horizontal, vertical)
+    CRTStripAccumulator acc[2][2];
+    auto add_strip = [&](int k, double adc_threshold) {
+      if (_crt_adc[k] <= adc_threshold) return;
+      if (_crt_orient[k] != kCRTVertical && _crt_orient[k] != kCRTHorizontal) return;
+      int face = (_crt_plane[k] == kFaceFront) ? 0 : 1;
+      acc[face][_crt_orient[k]].Add(_crt_time[k], _crt_adc[k], _crt_pos[k], _crt_module[k]);
+    };
+
+    add_strip(i, 500); // < 500 hardcoded
+
+    // look for hits at the same time as hit i, in their original order
+    group.clear();
+    auto first = std::lower_bound(sorted_time.begin(), sorted_time.end(), _crt_time[i] - 2*window);
+    for (auto it = first; it != sorted_time.end() && *it < _crt_time[i] + 2*window; ++it) {
+      int j = time_order[it - sorted_time.begin()];
+      if (j > i && fabs(_crt_time[i]-_crt_time[j]) < window) group.push_back(j);
+    }
+    std::sort(group.begin(), group.end());
+    for (int j : group) {
+      grouped[j] = true;
+      add_strip(j, 1000);
+    }
+
+    const CRTStripAccumulator& p1x = acc[0][kCRTVertical];
+    const CRTStripAccumulator& p1y = acc[0][kCRTHorizontal];
+    const CRTStripAccumulator& p2x = acc[1][kCRTVertical];
+    const CRTStripAccumulator& p2y = acc[1][kCRTHorizontal];
+    if (p1x.nhits>0 && p1y.nhits>0 && p2x.nhits>0 && p2y.nhits>0 && p1x.adc<9000 && p1y.adc<9000 && p2x.adc<9000 && p2y.adc<9000) {
+      // make a track!
+      _ctrk_x1.push_back(p1x.pos);
+      _ctrk_y1.push_back(p1y.pos);
+      _ctrk_z1.push_back(-239.95);
+      _ctrk_t1.push_back(0.5*(p1x.time+p1y.time));
+      _ctrk_adc1.push_back(p1x.adc+p1y.adc);
+      _ctrk_mod1x.push_back((int)p1x.module);
+      _ctrk_x2.push_back(p2x.pos);
+      _ctrk_y2.push_back(p2y.pos);
+      _ctrk_z2.push_back(656.25);
+      _ctrk_t2.push_back(0.5*(p2x.time+p2y.time));
+      _ctrk_adc2.push_back(p2x.adc+p2y.adc);
+      _ctrk_mod2x.push_back((int)p2x.module);
+    }
+  }
+  _nctrks = _ctrk_x1.size();
+}
+
  void Hitdumper::beginJob()
  {
   // Implementation of optional member function here.
@@ -643,72 +589,72 @@ void Hitdumper::analyze(const art::Event& evt)
   fTree->Branch("evttime",&_evttime,"evttime/D");
   fTree->Branch("t0",&_t0,"t0/I");
   fTree->Branch("nhits",&_nhits,"nhits/I");
-  fTree->Branch("hit_cryostat",_hit_cryostat,"hit_cryostat[nhits]/I");
-  fTree->Branch("hit_tpc",_hit_tpc,"hit_tpc[nhits]/I");
-  fTree->Branch("hit_plane",_hit_plane,"hit_plane[nhits]/I");
-  fTree->Branch("hit_wire",_hit_wire,"hit_wire[nhits]/I");
-  fTree->Branch("hit_channel",_hit_channel,"hit_channel[nhits]/I");
-  fTree->Branch("hit_peakT",_hit_peakT,"hit_peakT[nhits]/D");
-  fTree->Branch("hit_charge",_hit_charge,"hit_charge[nhits]/D");
-  fTree->Branch("hit_ph",_hit_ph,"hit_ph[nhits]/D");
-  fTree->Branch("hit_width",_hit_width,"hit_width[nhits]/D");
+  fTree->Branch("hit_cryostat",&_hit_cryostat);
+  fTree->Branch("hit_tpc",&_hit_tpc);
+  fTree->Branch("hit_plane",&_hit_plane);
+  fTree->Branch("hit_wire",&_hit_wire);
+  fTree->Branch("hit_channel",&_hit_channel);
+  fTree->Branch("hit_peakT",&_hit_peakT);
+  fTree->Branch("hit_charge",&_hit_charge);
+  fTree->Branch("hit_ph",&_hit_ph);
+  fTree->Branch("hit_width",&_hit_width);
   if (fkeepCRTstrips) {
     fTree->Branch("nstrips",&_nstrips,"nstrips/I");
-    fTree->Branch("crt_plane",_crt_plane,"crt_plane[nstrips]/I");
-    fTree->Branch("crt_module",_crt_module,"crt_module[nstrips]/I");
-    fTree->Branch("crt_strip",_crt_strip,"crt_strip[nstrips]/I");
-    fTree->Branch("crt_orient",_crt_orient,"crt_orient[nstrips]/I");
-    fTree->Branch("crt_time",_crt_time,"crt_time[nstrips]/D");
-    fTree->Branch("crt_adc",_crt_adc,"crt_adc[nstrips]/D");
-    fTree->Branch("crt_pos",_crt_pos,"crt_pos[nstrips]/D");
+    fTree->Branch("crt_plane",&_crt_plane);
+    fTree->Branch("crt_module",&_crt_module);
+    fTree->Branch("crt_strip",&_crt_strip);
+    fTree->Branch("crt_orient",&_crt_orient);
+    fTree->Branch("crt_time",&_crt_time);
+    fTree->Branch("crt_adc",&_crt_adc);
+    fTree->Branch("crt_pos",&_crt_pos);
   }
   if (fmakeCRTtracks) {
     fTree->Branch("nctrks",&_nctrks,"nctrks/I");
-    fTree->Branch("ctrk_x1",_ctrk_x1,"ctrk_x1[nctrks]/D");
-    fTree->Branch("ctrk_y1",_ctrk_y1,"ctrk_y1[nctrks]/D");
-    fTree->Branch("ctrk_z1",_ctrk_z1,"ctrk_z1[nctrks]/D");
-    fTree->Branch("ctrk_t1",_ctrk_t1,"ctrk_t1[nctrks]/D");
-    fTree->Branch("ctrk_adc1",_ctrk_adc1,"ctrk_adc1[nctrks]/D");
-    fTree->Branch("ctrk_mod1x",_ctrk_mod1x,"ctrk_mod1x[nctrks]/I");
-    fTree->Branch("ctrk_x2",_ctrk_x2,"ctrk_x2[nctrks]/D");
-    fTree->Branch("ctrk_y2",_ctrk_y2,"ctrk_y2[nctrks]/D");
-    fTree->Branch("ctrk_z2",_ctrk_z2,"ctrk_z2[nctrks]/D");
-    fTree->Branch("ctrk_t2",_ctrk_t2,"ctrk_t2[nctrks]/D");
-    fTree->Branch("ctrk_adc2",_ctrk_adc2,"ctrk_adc2[nctrks]/D");
-    fTree->Branch("ctrk_mod2x",_ctrk_mod2x,"ctrk_mod2x[nctrks]/I");
+    fTree->Branch("ctrk_x1",&_ctrk_x1);
+    fTree->Branch("ctrk_y1",&_ctrk_y1);
+    fTree->Branch("ctrk_z1",&_ctrk_z1);
+    fTree->Branch("ctrk_t1",&_ctrk_t1);
+    fTree->Branch("ctrk_adc1",&_ctrk_adc1);
+    fTree->Branch("ctrk_mod1x",&_ctrk_mod1x);
+    fTree->Branch("ctrk_x2",&_ctrk_x2);
+    fTree->Branch("ctrk_y2",&_ctrk_y2);
+    fTree->Branch("ctrk_z2",&_ctrk_z2);
+    fTree->Branch("ctrk_t2",&_ctrk_t2);
+    fTree->Branch("ctrk_adc2",&_ctrk_adc2);
+    fTree->Branch("ctrk_mod2x",&_ctrk_mod2x);
   }
   if (fkeepCRThits) {
     fTree->Branch("nchits",&_nchits,"nchits/I");
-    fTree->Branch("chit_x",_chit_x,"chit_x[nchits]/D");
-    fTree->Branch("chit_y",_chit_y,"chit_y[nchits]/D");
-    fTree->Branch("chit_z",_chit_z,"chit_z[nchits]/D");
-    fTree->Branch("chit_time",_chit_time,"chit_time[nchits]/D");
-    fTree->Branch("chit_plane",_chit_plane,"chit_plane[nchits]/I");    
+    fTree->Branch("chit_x",&_chit_x);
+    fTree->Branch("chit_y",&_chit_y);
+    fTree->Branch("chit_z",&_chit_z);
+    fTree->Branch("chit_time",&_chit_time);
+    fTree->Branch("chit_plane",&_chit_plane);    
   }
   if (freadCRTtracks) {
     fTree->Branch("ncts",&_ncts,"ncts/I");
-    fTree->Branch("ct_x1",_ct_x1,"ct_x1[ncts]/D");
-    fTree->Branch("ct_y1",_ct_y1,"ct_y1[ncts]/D");
-    fTree->Branch("ct_z1",_ct_z1,"ct_z1[ncts]/D");
-    fTree->Branch("ct_x2",_ct_x2,"ct_x2[ncts]/D");
-    fTree->Branch("ct_y2",_ct_y2,"ct_y2[ncts]/D");
-    fTree->Branch("ct_z2",_ct_z2,"ct_z2[ncts]/D");
-    fTree->Branch("ct_time",_ct_time,"ct_time[ncts]/D");
-    fTree->Branch("ct_pes",_ct_pes,"ct_pes[ncts]/D");
+    fTree->Branch("ct_x1",&_ct_x1);
+    fTree->Branch("ct_y1",&_ct_y1);
+    fTree->Branch("ct_z1",&_ct_z1);
+    fTree->Branch("ct_x2",&_ct_x2);
+    fTree->Branch("ct_y2",&_ct_y2);
+    fTree->Branch("ct_z2",&_ct_z2);
+    fTree->Branch("ct_time",&_ct_time);
+    fTree->Branch("ct_pes",&_ct_pes);
   }
 
   if (freadOpHits) {
     fTree->Branch("nophits",&_nophits,"nophits/I");
-    fTree->Branch("ophit_opch",_ophit_opch,"ophit_opch[nophits]/D");
-    fTree->Branch("ophit_opdet",_ophit_opdet,"ophit_opdet[nophits]/D");
-    fTree->Branch("ophit_peakT",_ophit_peakT,"ophit_peakT[nophits]/D");
-    fTree->Branch("ophit_width",_ophit_width,"ophit_width[nophits]/D");
-    fTree->Branch("ophit_area",_ophit_area,"ophit_area[nophits]/D");
-    fTree->Branch("ophit_amplitude",_ophit_amplitude,"ophit_amplitude[nophits]/D");
-    fTree->Branch("ophit_pe",_ophit_pe,"ophit_pe[nophits]/D");
-    fTree->Branch("ophit_opdet_x",_ophit_opdet_x,"ophit_opdet_x[nophits]/D");
-    fTree->Branch("ophit_opdet_y",_ophit_opdet_y,"ophit_opdet_y[nophits]/D");
-    fTree->Branch("ophit_opdet_z",_ophit_opdet_z,"ophit_opdet_z[nophits]/D");
+    fTree->Branch("ophit_opch",&_ophit_opch);
+    fTree->Branch("ophit_opdet",&_ophit_opdet);
+    fTree->Branch("ophit_peakT",&_ophit_peakT);
+    fTree->Branch("ophit_width",&_ophit_width);
+    fTree->Branch("ophit_area",&_ophit_area);
+    fTree->Branch("ophit_amplitude",&_ophit_amplitude);
+    fTree->Branch("ophit_pe",&_ophit_pe);
+    fTree->Branch("ophit_opdet_x",&_ophit_opdet_x);
+    fTree->Branch("ophit_opdet_y",&_ophit_opdet_y);
+    fTree->Branch("ophit_opdet_z",&_ophit_opdet_z);
   }
   
 }
@@ -721,79 +667,67 @@ void Hitdumper::ResetVars(){
   _evttime = -99999;
   _t0 = -99999;
   _nhits = 0;
-  for (int i = 0; i < kMaxHits; ++i){
-    _hit_cryostat[i] = -99999;
-    _hit_tpc[i] = -99999;
-    _hit_plane[i] = -99999;
-    _hit_wire[i] = -99999;
-    _hit_channel[i] = -99999;
-    _hit_peakT[i] = -99999;
-    _hit_charge[i] = -99999;
-    _hit_ph[i] = -99999;
-    _hit_width[i] = -99999;
-  }
+  _hit_cryostat.clear();
+  _hit_tpc.clear();
+  _hit_plane.clear();
+  _hit_wire.clear();
+  _hit_channel.clear();
+  _hit_peakT.clear();
+  _hit_charge.clear();
+  _hit_ph.clear();
+  _hit_width.clear();
+
   _nstrips=0;
-  for (int i = 0; i < kMaxCHits; ++i) {
-    _crt_plane[i]=-999;
-    _crt_module[i]=-999;
-    _crt_strip[i]=-999;
-    _crt_orient[i]=-999;
-    _crt_time[i]=-9999999.;
-    _crt_adc[i]=-999999.;
-    _crt_pos[i]=-999999.;
-  }
+  _crt_plane.clear();
+  _crt_module.clear();
+  _crt_strip.clear();
+  _crt_orient.clear();
+  _crt_time.clear();
+  _crt_adc.clear();
+  _crt_pos.clear();
   
   _nctrks=0;
-  for (int i = 0; i < kMaxNCtrks; ++i) {
-    _ctrk_x1[i]=-9999.;
-    _ctrk_y1[i]=-9999.;
-    _ctrk_z1[i]=-9999.;
-    _ctrk_t1[i]=-9999.;
-    _ctrk_adc1[i]=-9999.;
-    _ctrk_mod1x[i]=-99;
-    _ctrk_x2[i]=-9999.;
-    _ctrk_y2[i]=-9999.;
-    _ctrk_z2[i]=-9999.;
-    _ctrk_t2[i]=-9999.;
-    _ctrk_adc2[i]=-9999.;
-    _ctrk_mod2x[i]=-99;
-  }
+  _ctrk_x1.clear();
+  _ctrk_y1.clear();
+  _ctrk_z1.clear();
+  _ctrk_t1.clear();
+  _ctrk_adc1.clear();
+  _ctrk_mod1x.clear();
+  _ctrk_x2.clear();
+  _ctrk_y2.clear();
+  _ctrk_z2.clear();
+  _ctrk_t2.clear();
+  _ctrk_adc2.clear();
+  _ctrk_mod2x.clear();
 
   _ncts=0;
-  for (int i = 0; i < kMaxNCtrks; ++i) {
-    _ct_x1[i]=-9999.;
-    _ct_y1[i]=-9999.;
-    _ct_z1[i]=-9999.;
-    _ct_time[i]=-9999.;
-    _ct_pes[i]=-9999.;
-    _ct_x2[i]=-9999.;
-    _ct_y2[i]=-9999.;
-    _ct_z2[i]=-9999.;
-  }
-
+  _ct_x1.clear();
+  _ct_y1.clear();
+  _ct_z1.clear();
+  _ct_time.clear();
+  _ct_pes.clear();
+  _ct_x2.clear();
+  _ct_y2.clear();
+  _ct_z2.clear();
 
   _nchits=0;
-  for (int i = 0; i < kMaxCHits;++i) {
-    _chit_plane[i] = -999;
-    _chit_time[i] = -999.9;
-    _chit_x[i] = -999.9;
-    _chit_y[i] = -999.9;
-    _chit_z[i] = -999.9;
-  }
+  _chit_plane.clear();
+  _chit_time.clear();
+  _chit_x.clear();
+  _chit_y.clear();
+  _chit_z.clear();
 
   _nophits = 0;
-  for (int i = 0; i < kMaxHits; ++i){
-    _ophit_opch[i] = -9999.;
-    _ophit_opdet[i] = -9999.;
-    _ophit_peakT[i] = -9999.;
-    _ophit_width[i] = -9999.;
-    _ophit_area[i] = -9999.;
-    _ophit_amplitude[i] = -9999.;
-    _ophit_pe[i] = -9999.;
-    _ophit_opdet_x[i] = -9999.;
-    _ophit_opdet_y[i] = -9999.;
-    _ophit_opdet_z[i] = -9999.;
-  }
+  _ophit_opch.clear();
+  _ophit_opdet.clear();
+  _ophit_peakT.clear();
+  _ophit_width.clear();
+  _ophit_area.clear();
+  _ophit_amplitude.clear();
+  _ophit_pe.clear();
+  _ophit_opdet_x.clear();
+  _ophit_opdet_y.clear();
+  _ophit_opdet_z.clear();
   
 }
 
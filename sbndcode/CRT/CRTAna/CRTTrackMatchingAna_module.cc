@@ -284,11 +284,14 @@ namespace sbnd {
       double trueTime = particles[trackTrueID].T() * 1e-3;
       if(trueTime < minTrackTime || trueTime > maxTrackTime) continue;
 
+      // Track geometry used by all the matching below
+      TPCGeoUtil::TrackSummary trackSummary = trackAlg.MakeTrackSummary(tpcTrack, hits);
+
       //----------------------------------------------------------------------------------------------------------
       //                                        SINGLE ANGLE CUT ANALYSIS
       //----------------------------------------------------------------------------------------------------------
       // Find the closest track by angle
-      std::pair<crt::CRTTrack, double> closestAngle = trackAlg.ClosestCRTTrackByAngle(tpcTrack, crtTracks, event);
+      std::pair<crt::CRTTrack, double> closestAngle = trackAlg.ClosestCRTTrackByAngle(trackSummary, crtTracks);
       if(closestAngle.second != -99999){ 
         hAngle->Fill(closestAngle.second);
       }
@@ -335,7 +338,7 @@ namespace sbnd {
       //                                        SINGLE DCA CUT ANALYSIS
       //----------------------------------------------------------------------------------------------------------
       // Find the closest track by average distance of closest approach
-      std::pair<crt::CRTTrack, double> closestDCA = trackAlg.ClosestCRTTrackByDCA(tpcTrack, crtTracks, event);
+      std::pair<crt::CRTTrack, double> closestDCA = trackAlg.ClosestCRTTrackByDCA(trackSummary, crtTracks);
       if(closestDCA.second != -99999){
         hDCA->Fill(closestDCA.second);
       }
@@ -381,11 +384,11 @@ namespace sbnd {
       //----------------------------------------------------------------------------------------------------------
       //                                    JOINT DCA AND ANGLE CUT ANALYSIS
       //----------------------------------------------------------------------------------------------------------
-      std::vector<crt::CRTTrack> possTracks = trackAlg.AllPossibleCRTTracks(tpcTrack, crtTracks, event);
+      std::vector<crt::CRTTrack> possTracks = trackAlg.AllPossibleCRTTracks(trackSummary, crtTracks);
       for(auto const& possTrack : possTracks){
         int crtTrueID = fCrtBackTrack.TrueIdFromTotalEnergy(event, possTrack);
-        double angle = trackAlg.AngleBetweenTracks(tpcTrack, possTrack);
-        double DCA = trackAlg.AveDCABetweenTracks(tpcTrack, possTrack, event);
+        double angle = trackAlg.AngleBetweenTracks(trackSummary, possTrack);
+        double DCA = trackAlg.AveDCABetweenTracks(trackSummary, possTrack, trackAlg.CRTTrackShift(trackSummary, possTrack));
         if(crtTrueID == trackTrueID && crtTrueID != -99999){
           hMatchAngleDCA->Fill(angle, DCA);
         }
@@ -0,0 +1,134 @@
+#include "sbndcode/CRT/CRTProducts/CRTCompactHit.hh"
+
+namespace sbnd {
+namespace crt {
+
+  namespace {
+    const char* kTaggerNames[kNTaggers] = {"volTaggerBot_0", "volTaggerFaceFront_0", "volTaggerFaceBack_0",
+                                           "volTaggerSideLeft_0", "volTaggerSideRight_0",
+                                           "volTaggerTopLow_0", "volTaggerTopHigh_0"};
+    const std::string kEmptyTagger = "";
+  }
+
+  std::string CRTTaggerName(int taggerId){
+    if(taggerId < 0 || taggerId >= kNTaggers) return "";
+    return kTaggerNames[taggerId];
+  }
+
+  int CRTTaggerIdFromName(const std::string& tagger){
+    for(int i = 0; i < kNTaggers; i++){
+      if(tagger == kTaggerNames[i]) return i;
+    }
+    return kNoTagger;
+  }
+
+  const std::string& CRTCompactHits::Tagger(size_t i) const{
+    int tagger = hits.at(i).tagger;
+    if(tagger < 0 || (size_t)tagger >= taggers.size()) return kEmptyTagger;
+    return taggers[tagger];
+  }
+
+  void CRTCompactHits::Add(const CRTHit& hit){
+
+    if(taggers.empty()){
+      for(int i = 0; i < kNTaggers; i++) taggers.push_back(kTaggerNames[i]);
+    }
+
+    CRTCompactHit compact;
+    compact.peshit      = hit.peshit;
+    compact.ts0_s       = hit.ts0_s;
+    compact.ts0_s_corr  = hit.ts0_s_corr;
+    compact.ts0_ns      = hit.ts0_ns;
+    compact.ts0_ns_corr = hit.ts0_ns_corr;
+    compact.ts1_ns      = hit.ts1_ns;
+    compact.plane       = hit.plane;
+    compact.x_pos       = hit.x_pos;
+    compact.x_err       = hit.x_err;
+    compact.y_pos       = hit.y_pos;
+    compact.y_err       = hit.y_err;
+    compact.z_pos       = hit.z_pos;
+    compact.z_err       = hit.z_err;
+
+    // Non standard tagger names are only searched for when they turn up
+    int tagger = CRTTaggerIdFromName(hit.tagger);
+    if(tagger == kNoTagger){
+      for(size_t i = kNTaggers; i < taggers.size(); i++){
+        if(taggers[i] == hit.tagger) tagger = i;
+      }
+      if(tagger == kNoTagger){
+        tagger = taggers.size();
+        taggers.push_back(hit.tagger);
+      }
+    }
+    compact.tagger = tagger;
+
+    compact.feb_offset = feb_id.size();
+    compact.feb_size   = hit.feb_id.size();
+    feb_id.insert(feb_id.end(), hit.feb_id.begin(), hit.feb_id.end());
+
+    compact.pes_offset = pes.size();
+    compact.empty_pes_offset = empty_pes_feb_id.size();
+    for(auto const& feb : hit.pesmap){
+      if(feb.second.empty()) empty_pes_feb_id.push_back(feb.first);
+      for(auto const& pe : feb.second){
+        pes.push_back({feb.first, pe.first, pe.second});
+      }
+    }
+    compact.pes_size = pes.size() - compact.pes_offset;
+    compact.empty_pes_size = empty_pes_feb_id.size() - compact.empty_pes_offset;
+
+    hits.push_back(compact);
+
+  }
+
+  CRTHit CRTCompactHits::ToCRTHit(size_t i) const{
+
+    const CRTCompactHit& compact = hits.at(i);
+
+    CRTHit hit;
+    hit.peshit      = compact.peshit;
+    hit.ts0_s       = compact.ts0_s;
+    hit.ts0_s_corr  = compact.ts0_s_corr;
+    hit.ts0_ns      = compact.ts0_ns;
+    hit.ts0_ns_corr = compact.ts0_ns_corr;
+    hit.ts1_ns      = compact.ts1_ns;
+    hit.plane       = compact.plane;
+    hit.x_pos       = compact.x_pos;
+    hit.x_err       = compact.x_err;
+    hit.y_pos       = compact.y_pos;
+    hit.y_err       = compact.y_err;
+    hit.z_pos       = compact.z_pos;
+    hit.z_err       = compact.z_err;
+    hit.tagger      = Tagger(i);
+
+    hit.feb_id.assign(feb_id.begin() + compact.feb_offset,
+                      feb_id.begin() + compact.feb_offset + compact.feb_size);
+
+    // Entries were written in map order so they can be appended per FEB
+    for(size_t j = compact.pes_offset; j < compact.pes_offset + compact.pes_size; j++){
+      hit.pesmap[pes[j].feb_id].emplace_back(pes[j].channel, pes[j].pe);
+    }
+    for(size_t j = compact.empty_pes_offset; j < compact.empty_pes_offset + compact.empty_pes_size; j++){
+      hit.pesmap[empty_pes_feb_id[j]];
+    }
+
+    return hit;
+
+  }
+
+  std::vector<CRTHit> CRTCompactHits::ToCRTHits() const{
+    std::vector<CRTHit> crtHits;
+    crtHits.reserve(hits.size());
+    for(size_t i = 0; i < hits.size(); i++) crtHits.push_back(ToCRTHit(i));
+    return crtHits;
+  }
+
+  CRTCompactHits MakeCompactHits(const std::vector<CRTHit>& hits){
+    CRTCompactHits compactHits;
+    compactHits.hits.reserve(hits.size());
+    for(auto const& hit : hits) compactHits.Add(hit);
+    return compactHits;
+  }
+
+} // namespace crt
+} // namespace sbnd
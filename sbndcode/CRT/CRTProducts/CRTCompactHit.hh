@@ -0,0 +1,119 @@
+/**
+ * \class CRTCompactHits
+ *
+ * \ingroup crt
+ *
+ * \brief Flat companion of a CRTHit collection
+ *
+ * Fixed size hit records with an integer tagger id, the FEB ids and per FEB
+ * PE entries of all hits are shared flat arrays addressed by offset and length.
+ * FEBs with an empty PE list in CRTHit::pesmap are kept in their own array so
+ * converting back gives the same CRTHit
+ *
+ */
+
+#ifndef CRTCompactHit_hh_
+#define CRTCompactHit_hh_
+
+#include "sbndcode/CRT/CRTProducts/CRTHit.hh"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace sbnd {
+namespace crt {
+
+    // Tagger ids of the standard geometry, indices into CRTCompactHits::taggers
+    enum CRTTaggerId {
+      kNoTagger = -1,
+      kTaggerBot = 0,
+      kTaggerFaceFront,
+      kTaggerFaceBack,
+      kTaggerSideLeft,
+      kTaggerSideRight,
+      kTaggerTopLow,
+      kTaggerTopHigh,
+      kNTaggers
+    };
+
+    // Tagger name of a standard tagger id, empty if not defined
+    std::string CRTTaggerName(int taggerId);
+    // Standard tagger id from the tagger name, kNoTagger if not defined
+    int CRTTaggerIdFromName(const std::string& tagger);
+
+    // One entry of CRTHit::pesmap
+    struct CRTCompactPes{
+
+      uint8_t feb_id;
+      int channel;
+      float pe;
+
+    };
+
+    struct CRTCompactHit{
+
+      float peshit;
+
+      uint32_t ts0_s;
+      int8_t ts0_s_corr;
+
+      uint32_t ts0_ns;
+      int32_t ts0_ns_corr;
+      int32_t ts1_ns;
+
+      int plane;
+      int16_t tagger;          // index into CRTCompactHits::taggers
+
+      float x_pos;
+      float x_err;
+      float y_pos;
+      float y_err;
+      float z_pos;
+      float z_err;
+
+      uint32_t feb_offset;     // first FEB id in CRTCompactHits::feb_id
+      uint32_t feb_size;
+      uint32_t pes_offset;     // first entry in CRTCompactHits::pes
+      uint32_t pes_size;
+      uint32_t empty_pes_offset; // first FEB in CRTCompactHits::empty_pes_feb_id
+      uint32_t empty_pes_size;
+
+      CRTCompactHit() {}
+
+    };
+
+    struct CRTCompactHits{
+
+      std::vector<CRTCompactHit> hits;
+      std::vector<uint8_t> feb_id;
+      std::vector<CRTCompactPes> pes;
+      // FEB ids of the pesmap entries with no PEs, which have nothing in pes
+      std::vector<uint8_t> empty_pes_feb_id;
+      // Standard taggers come first so their ids are the CRTTaggerId values,
+      // any other tagger name is added on the end
+      std::vector<std::string> taggers;
+
+      CRTCompactHits() {}
+
+      size_t size() const { return hits.size(); }
+
+      // Tagger name of a hit
+      const std::string& Tagger(size_t i) const;
+
+      // Append a CRTHit, flattening its FEB ids and PE map
+      void Add(const CRTHit& hit);
+
+      // Rebuild the full CRTHit for one hit or for the whole collection
+      CRTHit ToCRTHit(size_t i) const;
+      std::vector<CRTHit> ToCRTHits() const;
+
+    };
+
+    // Convert a collection of CRTHits to the compact form
+    CRTCompactHits MakeCompactHits(const std::vector<CRTHit>& hits);
+
+} // namespace crt
+} // namespace sbnd
+
+#endif
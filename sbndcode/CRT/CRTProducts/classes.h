@@ -2,6 +2,7 @@
 #include "canvas/Persistency/Common/Assns.h"
 #include "sbndcode/CRT/CRTProducts/CRTData.hh"
 #include "sbndcode/CRT/CRTProducts/CRTHit.hh"
+#include "sbndcode/CRT/CRTProducts/CRTCompactHit.hh"
 #include "sbndcode/CRT/CRTProducts/CRTTzero.hh"
 #include "sbndcode/CRT/CRTProducts/CRTTrack.hh"
 #include "lardataobj/Simulation/AuxDetSimChannel.h"
@@ -12,6 +12,7 @@
 // sbndcode includes
 #include "sbndcode/CRT/CRTProducts/CRTData.hh"
 #include "sbndcode/CRT/CRTProducts/CRTHit.hh"
+#include "sbndcode/CRT/CRTProducts/CRTCompactHit.hh"
 #include "sbndcode/CRT/CRTUtils/CRTHitRecoAlg.h"
 
 // Framework includes
@@ -96,6 +97,7 @@ namespace sbnd {
 
     // Params from fcl file.......
     art::InputTag fCrtModuleLabel;      ///< name of crt producer
+    bool          fProduceCompactHits;  ///< also put the hits in flat CRTCompactHits form
    
     CRTHitRecoAlg hitAlg;
 
@@ -113,6 +115,8 @@ namespace sbnd {
     
     reconfigure(p);
 
+    if(fProduceCompactHits) produces< crt::CRTCompactHits >();
+
   } // CRTSimHitProducer()
 
 
@@ -120,6 +124,7 @@ namespace sbnd {
   {
 
     fCrtModuleLabel       = (p.get<art::InputTag> ("CrtModuleLabel")); 
+    fProduceCompactHits   = (p.get<bool>          ("ProduceCompactHits", false));
 
   } // CRTSimHitProducer::reconfigure()
 
@@ -163,6 +168,9 @@ namespace sbnd {
       }
     }
       
+    if(fProduceCompactHits){
+      event.put(std::make_unique<crt::CRTCompactHits>(crt::MakeCompactHits(*CRTHitcol)));
+    }
 
     event.put(std::move(CRTHitcol));
     event.put(std::move(Hitassn));
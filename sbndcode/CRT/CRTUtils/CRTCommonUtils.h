@@ -25,7 +25,7 @@ namespace CRTCommonUtils{
   double SimpleDCA(crt::CRTHit hit, TVector3 start, TVector3 direction);
 
   // Minimum distance from infinite track to CRT hit assuming that hit is a 2D square
-  double DistToCrtHit(crt::CRTHit hit, TVector3 start, TVector3 end);
+  double DistToCrtHit(const crt::CRTHit& hit, TVector3 start, TVector3 end);
 
   // Distance between infinite line (2) and segment (1)
   // http://geomalgorithms.com/a07-_distance.html
@@ -130,52 +130,71 @@ void CRTEventDisplay::DrawCube(TCanvas *c1, double *rmin, double *rmax, int colo
 
 }
 
+void CRTEventDisplay::DrawCube(TCanvas *c1, const Box& box, int colour){
+  double rmin[3] = {box.rmin[0], box.rmin[1], box.rmin[2]};
+  double rmax[3] = {box.rmax[0], box.rmax[1], box.rmax[2]};
+  DrawCube(c1, rmin, rmax, colour);
+}
+
+void CRTEventDisplay::CacheGeometry(){
+
+  fTaggerBoxes.clear();
+  fModuleBoxes.clear();
+  fTpcBoxes.clear();
+  fStripBoxes.clear();
+
+  for(size_t i = 0; i < fCrtGeo.NumTaggers(); i++){
+    CRTTaggerGeo tagger = fCrtGeo.GetTagger(i);
+    fTaggerBoxes.push_back({{tagger.minX, tagger.minY, tagger.minZ},
+                            {tagger.maxX, tagger.maxY, tagger.maxZ}});
+  }
+
+  // Strips are reached through their modules so the channel lookup is a single pass over the geometry
+  for(size_t i = 0; i < fCrtGeo.NumModules(); i++){
+    CRTModuleGeo module = fCrtGeo.GetModule(i);
+    fModuleBoxes.push_back({{module.minX, module.minY, module.minZ},
+                            {module.maxX, module.maxY, module.maxZ}});
+    for(auto const& strip : module.strips){
+      StripBox stripBox = {{{strip.second.minX, strip.second.minY, strip.second.minZ},
+                            {strip.second.maxX, strip.second.maxY, strip.second.maxZ}},
+                           module.tagger};
+      fStripBoxes[strip.second.sipms.first] = stripBox;
+      fStripBoxes[strip.second.sipms.second] = stripBox;
+    }
+  }
+
+  // TPC with central cathode
+  fTpcBoxes.push_back({{fTpcGeo.MinX(), fTpcGeo.MinY(), fTpcGeo.MinZ()},
+                       {-fTpcGeo.CpaWidth(), fTpcGeo.MaxY(), fTpcGeo.MaxZ()}});
+  fTpcBoxes.push_back({{fTpcGeo.CpaWidth(), fTpcGeo.MinY(), fTpcGeo.MinZ()},
+                       {fTpcGeo.MaxX(), fTpcGeo.MaxY(), fTpcGeo.MaxZ()}});
+
+  fCrtLimits = fCrtGeo.CRTLimits();
+
+  fGeometryCached = true;
+
+}
+
 void CRTEventDisplay::Draw(const art::Event& event){
   // Create a canvas 
   TCanvas *c1 = new TCanvas("c1","",700,700);
 
+  // Static geometry doesn't change between events
+  if(!fGeometryCached) CacheGeometry();
+
   // Draw the CRT taggers
   if(fDrawTaggers){
-    for(size_t i = 0; i < fCrtGeo.NumTaggers(); i++){
-      double rmin[3] = {fCrtGeo.GetTagger(i).minX, 
-                        fCrtGeo.GetTagger(i).minY, 
-                        fCrtGeo.GetTagger(i).minZ};
-      double rmax[3] = {fCrtGeo.GetTagger(i).maxX, 
-                        fCrtGeo.GetTagger(i).maxY, 
-                        fCrtGeo.GetTagger(i).maxZ};
-      DrawCube(c1, rmin, rmax, fTaggerColour);
-    }
+    for(auto const& box : fTaggerBoxes) DrawCube(c1, box, fTaggerColour);
   }
 
   // Draw individual CRT modules
   if(fDrawModules){
-    for(size_t i = 0; i < fCrtGeo.NumModules(); i++){
-      double rmin[3] = {fCrtGeo.GetModule(i).minX, 
-                        fCrtGeo.GetModule(i).minY, 
-                        fCrtGeo.GetModule(i).minZ};
-      double rmax[3] = {fCrtGeo.GetModule(i).maxX, 
-                        fCrtGeo.GetModule(i).maxY, 
-                        fCrtGeo.GetModule(i).maxZ};
-      DrawCube(c1, rmin, rmax, fTaggerColour);
-    }
+    for(auto const& box : fModuleBoxes) DrawCube(c1, box, fTaggerColour);
   }
 
   // Draw the TPC with central cathode
   if(fDrawTpc){
-    double rmin[3] = {fTpcGeo.MinX(), 
-                      fTpcGeo.MinY(), 
-                      fTpcGeo.MinZ()};
-    double rmax[3] = {-fTpcGeo.CpaWidth(), 
-                      fTpcGeo.MaxY(), 
-                      fTpcGeo.MaxZ()};
-    DrawCube(c1, rmin, rmax, fTpcColour);
-    double rmin2[3] = {fTpcGeo.CpaWidth(), 
-                      fTpcGeo.MinY(), 
-                      fTpcGeo.MinZ()};
-    double rmax2[3] = {fTpcGeo.MaxX(), 
-                      fTpcGeo.MaxY(), 
-                      fTpcGeo.MaxZ()};
-    DrawCube(c1, rmin2, rmax2, fTpcColour);
+    for(auto const& box : fTpcBoxes) DrawCube(c1, box, fTpcColour);
   }
 
   // Draw the CRT data in the event
@@ -198,17 +217,12 @@ void CRTEventDisplay::Draw(const art::Event& event){
       int trueId = fCrtBackTrack.TrueIdFromTotalEnergy(event, data);
       if(fUseTrueID && trueId != fTrueID) continue;
 
-      std::string stripName = fCrtGeo.ChannelToStripName(data.Channel());
-      double rmin[3] = {fCrtGeo.GetStrip(stripName).minX, 
-                        fCrtGeo.GetStrip(stripName).minY, 
-                        fCrtGeo.GetStrip(stripName).minZ};
-      double rmax[3] = {fCrtGeo.GetStrip(stripName).maxX, 
-                        fCrtGeo.GetStrip(stripName).maxY, 
-                        fCrtGeo.GetStrip(stripName).maxZ};
-      DrawCube(c1, rmin, rmax, fCrtDataColour);
+      auto stripIt = fStripBoxes.find(data.Channel());
+      if(stripIt == fStripBoxes.end()) continue;
+      DrawCube(c1, stripIt->second.box, fCrtDataColour);
 
       if(fPrint) std::cout<<"->True ID: "<<trueId<<", channel = "<<data.Channel()<<", tagger = "
-                          <<fCrtGeo.GetModule(fCrtGeo.GetStrip(stripName).module).tagger<<", time = "<<time<<"\n";
+                          <<stripIt->second.tagger<<", time = "<<time<<"\n";
     }
   }
 
@@ -331,7 +345,7 @@ void CRTEventDisplay::Draw(const art::Event& event){
     if(fPrint) std::cout<<"\nTrue tracks in event:\n";
 
     auto particleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fSimLabel);
-    std::vector<double> crtLims = fCrtGeo.CRTLimits();
+    const std::vector<double>& crtLims = fCrtLimits;
     for(auto const& part : (*particleHandle)){
 
       // Skip if it doesn't match the true ID if true ID is used
@@ -40,6 +40,8 @@
 
 // c++
 #include <vector>
+#include <map>
+#include <string>
 
 // ROOT
 #include "TVector3.h"
@@ -191,6 +193,23 @@ namespace sbnd{
 
   private:
 
+    // Axis aligned box to be drawn as an outline
+    struct Box {
+      double rmin[3];
+      double rmax[3];
+    };
+
+    // Strip box with the name of its tagger, looked up by SiPM channel
+    struct StripBox {
+      Box box;
+      std::string tagger;
+    };
+
+    // Fill the static geometry boxes and channel lookup, only done once per job
+    void CacheGeometry();
+
+    void DrawCube(TCanvas *c1, const Box& box, int colour);
+
     TPCGeoAlg fTpcGeo;
     CRTGeoAlg fCrtGeo;
 
@@ -232,6 +251,13 @@ namespace sbnd{
     double fMinTime;
     double fMaxTime;
 
+    bool fGeometryCached = false;
+    std::vector<Box> fTaggerBoxes;
+    std::vector<Box> fModuleBoxes;
+    std::vector<Box> fTpcBoxes;
+    std::map<uint32_t, StripBox> fStripBoxes;
+    std::vector<double> fCrtLimits;
+
   };
 
 }
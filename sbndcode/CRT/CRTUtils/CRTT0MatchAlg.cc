@@ -9,6 +9,7 @@ CRTT0MatchAlg::CRTT0MatchAlg(const Config& config, geo::GeometryCore const *Geom
   this->reconfigure(config);
   fDetectorProperties = DetectorProperties;
   fGeometryService = GeometryService;
+  fTPCDriftTable = TPCGeoUtil::MakeTPCDriftTable(fGeometryService);
 }
 
 
@@ -64,7 +65,7 @@ std::pair<double, double> CRTT0MatchAlg::TrackT0Range(double startX, double endX
 } // CRTT0MatchAlg::TrackT0Range()
 
 
-double CRTT0MatchAlg::DistOfClosestApproach(TVector3 trackPos, TVector3 trackDir, crt::CRTHit crtHit, int driftDirection, double t0){
+double CRTT0MatchAlg::DistOfClosestApproach(TVector3 trackPos, const TVector3& trackDir, const crt::CRTHit& crtHit, int driftDirection, double t0){
 
   //double minDist = 99999;
 
@@ -80,45 +81,20 @@ double CRTT0MatchAlg::DistOfClosestApproach(TVector3 trackPos, TVector3 trackDir
 } // CRTT0MatchAlg::DistToOfClosestApproach()
 
 
-std::pair<TVector3, TVector3> CRTT0MatchAlg::TrackDirectionAverage(recob::Track track, double frac){
+std::pair<TVector3, TVector3> CRTT0MatchAlg::TrackDirectionAverage(const recob::Track& track, double frac){
 
-  // Calculate direction as an average over directions
-  size_t nTrackPoints = track.NumberTrajectoryPoints();
-  recob::TrackTrajectory trajectory  = track.Trajectory();
-  std::vector<geo::Vector_t> validDirections;
-  for(size_t i = 0; i < nTrackPoints; i++){
-    if(trajectory.FlagsAtPoint(i)!=recob::TrajectoryPointFlags::InvalidHitIndex) continue;
-    validDirections.push_back(track.DirectionAtPoint(i));
-  }
-
-  size_t nValidPoints = validDirections.size();
-  int endPoint = (int)floor(nValidPoints*frac);
-  double xTotStart = 0; double yTotStart = 0; double zTotStart = 0;
-  double xTotEnd = 0; double yTotEnd = 0; double zTotEnd = 0;
-  for(int i = 0; i < endPoint; i++){
-    geo::Vector_t dirStart = validDirections.at(i);
-    geo::Vector_t dirEnd = validDirections.at(nValidPoints - (i+1));
-    xTotStart += dirStart.X();
-    yTotStart += dirStart.Y();
-    zTotStart += dirStart.Z();
-    xTotEnd += dirEnd.X();
-    yTotEnd += dirEnd.Y();
-    zTotEnd += dirEnd.Z();
-  }
-  TVector3 startDir = {-xTotStart/endPoint, -yTotStart/endPoint, -zTotStart/endPoint};
-  TVector3 endDir = {xTotEnd/endPoint, yTotEnd/endPoint, zTotEnd/endPoint};
-
-  return std::make_pair(startDir, endDir);
+  return TPCGeoUtil::TrackDirectionAverage(track, frac);
 
 } // CRTT0MatchAlg::TrackDirectionAverage()
 
 
-std::pair<TVector3, TVector3> CRTT0MatchAlg::TrackDirectionAverageFromPoints(recob::Track track, double frac){
+std::pair<TVector3, TVector3> CRTT0MatchAlg::TrackDirectionAverageFromPoints(const recob::Track& track, double frac){
 
   // Calculate direction as an average over directions
   size_t nTrackPoints = track.NumberTrajectoryPoints();
-  recob::TrackTrajectory trajectory  = track.Trajectory();
+  const recob::TrackTrajectory& trajectory = track.Trajectory();
   std::vector<TVector3> validPoints;
+  validPoints.reserve(nTrackPoints);
   for(size_t i = 0; i < nTrackPoints; i++){
     if(trajectory.FlagsAtPoint(i) != recob::TrajectoryPointFlags::InvalidHitIndex) continue;
     validPoints.push_back(track.LocationAtPoint<TVector3>(i));
@@ -134,27 +110,36 @@ std::pair<TVector3, TVector3> CRTT0MatchAlg::TrackDirectionAverageFromPoints(rec
 } // CRTT0MatchAlg::TrackDirectionAverageFromPoints()
 
 
-std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(recob::Track tpcTrack, std::vector<sbnd::crt::CRTHit> crtHits, const art::Event& event) {
+TPCGeoUtil::TrackSummary CRTT0MatchAlg::MakeTrackSummary(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits) const{
+  return TPCGeoUtil::MakeTrackSummary(tpcTrack, hits, fTPCDriftTable, fTrackDirectionFrac);
+}
+
+
+std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(const recob::Track& tpcTrack, const std::vector<sbnd::crt::CRTHit>& crtHits, const art::Event& event) {
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return ClosestCRTHit(tpcTrack, hits, crtHits);
 }
 
-std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(recob::Track tpcTrack, std::pair<double, double> t0MinMax, std::vector<sbnd::crt::CRTHit> crtHits, int driftDirection) {
-  auto start = tpcTrack.Vertex<TVector3>();
-  auto end = tpcTrack.End<TVector3>();
+std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(const recob::Track& tpcTrack, std::pair<double, double> t0MinMax, const std::vector<sbnd::crt::CRTHit>& crtHits, int driftDirection) {
+  TPCGeoUtil::TrackSummary track = MakeTrackSummary(tpcTrack, {});
+  return ClosestCRTHit(track, t0MinMax, crtHits, driftDirection);
+}
 
-  // Calculate direction as an average over directions
-  std::pair<TVector3, TVector3> startEndDir = TrackDirectionAverage(tpcTrack, fTrackDirectionFrac);
-  TVector3 startDir = startEndDir.first;
-  TVector3 endDir = startEndDir.second;
+std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(const TPCGeoUtil::TrackSummary& track, std::pair<double, double> t0MinMax, const std::vector<sbnd::crt::CRTHit>& crtHits, int driftDirection) {
+  const TVector3& start = track.start;
+  const TVector3& end = track.end;
+
+  // Directions are averaged when the summary is made
+  const TVector3& startDir = track.startDir;
+  const TVector3& endDir = track.endDir;
 
   // ====================== Matching Algorithm ========================== //
   std::vector<std::pair<crt::CRTHit, double>> t0Candidates;
 
   // Loop over all the CRT hits
-  for(auto &crtHit : crtHits){
+  for(auto const& crtHit : crtHits){
     // Check if hit is within the allowed t0 range
     double crtTime = -99999.;
     if (fTSMode == 1) {
@@ -194,30 +179,38 @@ std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(recob::Track tpcTrac
 
 }
 
-std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<sbnd::crt::CRTHit> crtHits) {
-  auto start = tpcTrack.Vertex<TVector3>();
-  auto end = tpcTrack.End<TVector3>();
-  // Get the drift direction from the TPC
-  int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
-  std::pair<double, double> xLimits = TPCGeoUtil::XLimitsFromHits(fGeometryService, hits);
+std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<sbnd::crt::CRTHit>& crtHits) {
+  TPCGeoUtil::TrackSummary track = MakeTrackSummary(tpcTrack, hits);
+  return ClosestCRTHit(track, crtHits);
+}
+
+std::pair<crt::CRTHit, double> CRTT0MatchAlg::ClosestCRTHit(const TPCGeoUtil::TrackSummary& track, const std::vector<sbnd::crt::CRTHit>& crtHits) {
   // Get the allowed t0 range
-  std::pair<double, double> t0MinMax = TrackT0Range(start.X(), end.X(), driftDirection, xLimits);
+  std::pair<double, double> t0MinMax = TrackT0Range(track.start.X(), track.end.X(), track.driftDirection, track.xLimits);
 
-  return ClosestCRTHit(tpcTrack, t0MinMax, crtHits, driftDirection);
+  return ClosestCRTHit(track, t0MinMax, crtHits, track.driftDirection);
 }
 
-double CRTT0MatchAlg::T0FromCRTHits(recob::Track tpcTrack, std::vector<sbnd::crt::CRTHit> crtHits, const art::Event& event){
+double CRTT0MatchAlg::T0FromCRTHits(const recob::Track& tpcTrack, const std::vector<sbnd::crt::CRTHit>& crtHits, const art::Event& event){
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return T0FromCRTHits(tpcTrack, hits, crtHits);
 }
 
-double CRTT0MatchAlg::T0FromCRTHits(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<sbnd::crt::CRTHit> crtHits) {
+double CRTT0MatchAlg::T0FromCRTHits(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<sbnd::crt::CRTHit>& crtHits) {
 
   if (tpcTrack.Length() < fMinTrackLength) return -99999; 
 
-  std::pair<crt::CRTHit, double> closestHit = ClosestCRTHit(tpcTrack, hits, crtHits);
+  return T0FromCRTHits(MakeTrackSummary(tpcTrack, hits), crtHits);
+
+}
+
+double CRTT0MatchAlg::T0FromCRTHits(const TPCGeoUtil::TrackSummary& track, const std::vector<sbnd::crt::CRTHit>& crtHits) {
+
+  if (track.length < fMinTrackLength) return -99999; 
+
+  std::pair<crt::CRTHit, double> closestHit = ClosestCRTHit(track, crtHits);
   if(closestHit.second == -99999) return -99999;
 
   double crtTime;
@@ -233,19 +226,27 @@ double CRTT0MatchAlg::T0FromCRTHits(recob::Track tpcTrack, std::vector<art::Ptr<
 
 }
 
-std::pair<double, double> CRTT0MatchAlg::T0AndDCAFromCRTHits(recob::Track tpcTrack, std::vector<sbnd::crt::CRTHit> crtHits, const art::Event& event){
+std::pair<double, double> CRTT0MatchAlg::T0AndDCAFromCRTHits(const recob::Track& tpcTrack, const std::vector<sbnd::crt::CRTHit>& crtHits, const art::Event& event){
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return T0AndDCAFromCRTHits(tpcTrack, hits, crtHits);
 }
 
-std::pair<double, double> CRTT0MatchAlg::T0AndDCAFromCRTHits(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<sbnd::crt::CRTHit> crtHits) {
+std::pair<double, double> CRTT0MatchAlg::T0AndDCAFromCRTHits(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<sbnd::crt::CRTHit>& crtHits) {
+
+  if (tpcTrack.Length() < fMinTrackLength) return std::make_pair(-99999, -99999); 
+
+  return T0AndDCAFromCRTHits(MakeTrackSummary(tpcTrack, hits), crtHits);
+
+}
+
+std::pair<double, double> CRTT0MatchAlg::T0AndDCAFromCRTHits(const TPCGeoUtil::TrackSummary& track, const std::vector<sbnd::crt::CRTHit>& crtHits) {
 
   std::pair<double, double> null = std::make_pair(-99999, -99999);
-  if (tpcTrack.Length() < fMinTrackLength) return null; 
+  if (track.length < fMinTrackLength) return null; 
 
-  std::pair<crt::CRTHit, double> closestHit = ClosestCRTHit(tpcTrack, hits, crtHits);
+  std::pair<crt::CRTHit, double> closestHit = ClosestCRTHit(track, crtHits);
   if(closestHit.second == -99999) return null;
 
   double crtTime;
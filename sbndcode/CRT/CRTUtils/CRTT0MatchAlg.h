@@ -122,29 +122,37 @@ namespace sbnd{
     std::pair<double, double> TrackT0Range(double startX, double endX, int driftDirection, std::pair<double, double> xLimits);
 
     // Calculate the distance of closest approach (DCA) between the end of a track and a crt hit
-    double DistOfClosestApproach(TVector3 trackPos, TVector3 trackDir, crt::CRTHit crtHit, int driftDirection, double t0);
+    double DistOfClosestApproach(TVector3 trackPos, const TVector3& trackDir, const crt::CRTHit& crtHit, int driftDirection, double t0);
 
-    std::pair<TVector3, TVector3> TrackDirectionAverage(recob::Track track, double frac);
-    std::pair<TVector3, TVector3> TrackDirectionAverageFromPoints(recob::Track track, double frac);
+    std::pair<TVector3, TVector3> TrackDirectionAverage(const recob::Track& track, double frac);
+    std::pair<TVector3, TVector3> TrackDirectionAverageFromPoints(const recob::Track& track, double frac);
+
+    // Summarise the track geometry once, can be reused for every matching call on the same track
+    TPCGeoUtil::TrackSummary MakeTrackSummary(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits) const;
 
     // Return the closest CRT hit to a TPC track and the DCA
-    std::pair<crt::CRTHit, double> ClosestCRTHit(recob::Track tpcTrack, std::pair<double, double> t0MinMax, std::vector<sbnd::crt::CRTHit> crtHits, int driftDirection);
-    std::pair<crt::CRTHit, double> ClosestCRTHit(recob::Track tpcTrack, std::vector<sbnd::crt::CRTHit> crtHits, const art::Event& event);
-    std::pair<crt::CRTHit, double> ClosestCRTHit(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<sbnd::crt::CRTHit> crtHits);
+    std::pair<crt::CRTHit, double> ClosestCRTHit(const recob::Track& tpcTrack, std::pair<double, double> t0MinMax, const std::vector<sbnd::crt::CRTHit>& crtHits, int driftDirection);
+    std::pair<crt::CRTHit, double> ClosestCRTHit(const recob::Track& tpcTrack, const std::vector<sbnd::crt::CRTHit>& crtHits, const art::Event& event);
+    std::pair<crt::CRTHit, double> ClosestCRTHit(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<sbnd::crt::CRTHit>& crtHits);
+    std::pair<crt::CRTHit, double> ClosestCRTHit(const TPCGeoUtil::TrackSummary& track, std::pair<double, double> t0MinMax, const std::vector<sbnd::crt::CRTHit>& crtHits, int driftDirection);
+    std::pair<crt::CRTHit, double> ClosestCRTHit(const TPCGeoUtil::TrackSummary& track, const std::vector<sbnd::crt::CRTHit>& crtHits);
 
     // Match track to T0 from CRT hits
-    double T0FromCRTHits(recob::Track tpcTrack, std::vector<sbnd::crt::CRTHit> crtHits, const art::Event& event);
-    double T0FromCRTHits(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<sbnd::crt::CRTHit> crtHits);
+    double T0FromCRTHits(const recob::Track& tpcTrack, const std::vector<sbnd::crt::CRTHit>& crtHits, const art::Event& event);
+    double T0FromCRTHits(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<sbnd::crt::CRTHit>& crtHits);
+    double T0FromCRTHits(const TPCGeoUtil::TrackSummary& track, const std::vector<sbnd::crt::CRTHit>& crtHits);
 
     // Match track to T0 from CRT hits, also return the DCA
-    std::pair<double, double> T0AndDCAFromCRTHits(recob::Track tpcTrack, std::vector<sbnd::crt::CRTHit> crtHits, const art::Event& event);
-    std::pair<double, double> T0AndDCAFromCRTHits(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<sbnd::crt::CRTHit> crtHits);
+    std::pair<double, double> T0AndDCAFromCRTHits(const recob::Track& tpcTrack, const std::vector<sbnd::crt::CRTHit>& crtHits, const art::Event& event);
+    std::pair<double, double> T0AndDCAFromCRTHits(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<sbnd::crt::CRTHit>& crtHits);
+    std::pair<double, double> T0AndDCAFromCRTHits(const TPCGeoUtil::TrackSummary& track, const std::vector<sbnd::crt::CRTHit>& crtHits);
 
 
   private:
 
     detinfo::DetectorProperties const* fDetectorProperties;
     geo::GeometryCore const* fGeometryService;
+    TPCGeoUtil::TPCDriftTable fTPCDriftTable;
 
     double fMinTrackLength;
     double fTrackDirectionFrac;
@@ -1,5 +1,8 @@
 #include "CRTTrackMatchAlg.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace sbnd{
 
 CRTTrackMatchAlg::CRTTrackMatchAlg(const Config& config) : CRTTrackMatchAlg(config, lar::providerFrom<geo::Geometry>(), lar::providerFrom<detinfo::DetectorPropertiesService>()) 
@@ -10,6 +13,7 @@ CRTTrackMatchAlg::CRTTrackMatchAlg(const Config& config, geo::GeometryCore const
   this->reconfigure(config);
 
   fGeometryService = GeometryService;
+  fTPCDriftTable = TPCGeoUtil::MakeTPCDriftTable(fGeometryService);
   fDetectorProperties = DetectorProperties;
   
 }
@@ -41,7 +45,7 @@ void CRTTrackMatchAlg::reconfigure(const Config& config){
 
 // Calculate intersection between CRT track and TPC (AABB Ray-Box intersection)
 // (https://www.scratchapixel.com/lessons/3d-basic-rendering/minimal-ray-tracer-rendering-simple-shapes/ray-box-intersection)
-std::pair<TVector3, TVector3> CRTTrackMatchAlg::TpcIntersection(const geo::TPCGeo& tpcGeo, crt::CRTTrack track){
+std::pair<TVector3, TVector3> CRTTrackMatchAlg::TpcIntersection(const geo::TPCGeo& tpcGeo, const crt::CRTTrack& track){
 
   // Find the intersection between the track and the TPC
   TVector3 start (track.x1_pos, track.y1_pos, track.z1_pos);
@@ -68,7 +72,7 @@ std::pair<TVector3, TVector3> CRTTrackMatchAlg::TpcIntersection(const geo::TPCGe
 
 
 // Function to calculate if a CRTTrack crosses the TPC volume
-bool CRTTrackMatchAlg::CrossesTPC(crt::CRTTrack track){
+bool CRTTrackMatchAlg::CrossesTPC(const crt::CRTTrack& track){
 
   for(size_t c = 0; c < fGeometryService->Ncryostats(); c++){
     const geo::CryostatGeo& cryostat = fGeometryService->Cryostat(c);
@@ -82,26 +86,35 @@ bool CRTTrackMatchAlg::CrossesTPC(crt::CRTTrack track){
 
 } // CRTTrackMatchAlg::CrossesTPC()
 
-double CRTTrackMatchAlg::T0FromCRTTracks(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event) {
+TPCGeoUtil::TrackSummary CRTTrackMatchAlg::MakeTrackSummary(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits) const{
+  // Track directions aren't used for track matching
+  return TPCGeoUtil::MakeTrackSummary(tpcTrack, hits, fTPCDriftTable, 0.);
+}
+
+double CRTTrackMatchAlg::T0FromCRTTracks(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event) {
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return T0FromCRTTracks(tpcTrack, hits, crtTracks);
 }
 
-double CRTTrackMatchAlg::T0FromCRTTracks(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks) {
+double CRTTrackMatchAlg::T0FromCRTTracks(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks) {
+  return T0FromCRTTracks(MakeTrackSummary(tpcTrack, hits), crtTracks);
+}
+
+double CRTTrackMatchAlg::T0FromCRTTracks(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks) {
 
   std::pair<crt::CRTTrack, double> closest;
   if(fSelectionMetric == "angle"){ 
-    closest = ClosestCRTTrackByAngle(tpcTrack, hits, crtTracks);
+    closest = ClosestCRTTrackByAngle(track, crtTracks);
     if(closest.second == -99999 || closest.second > fMaxAngleDiff) return -99999;
   }
   else if(fSelectionMetric == "dca"){ 
-    closest = ClosestCRTTrackByDCA(tpcTrack, hits, crtTracks);
+    closest = ClosestCRTTrackByDCA(track, crtTracks);
     if(closest.second == -99999 || closest.second > fMaxDistance) return -99999;
   }
   else{
-    closest = ClosestCRTTrackByScore(tpcTrack, hits, crtTracks);
+    closest = ClosestCRTTrackByScore(track, crtTracks);
     if(closest.second == -99999 || closest.second > fMaxScore) return -99999;
   }
 
@@ -111,235 +124,294 @@ double CRTTrackMatchAlg::T0FromCRTTracks(recob::Track tpcTrack, std::vector<art:
 
 }
 
-int CRTTrackMatchAlg::GetMatchedCRTTrackId(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event){
+int CRTTrackMatchAlg::GetMatchedCRTTrackId(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event){
   std::pair<int, double> result = GetMatchedCRTTrackIdAndScore(tpcTrack, crtTracks, event);
   return result.first;
 }
 
 // Find the closest valid matching CRT track ID
-int CRTTrackMatchAlg::GetMatchedCRTTrackId(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks) {
+int CRTTrackMatchAlg::GetMatchedCRTTrackId(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks) {
   std::pair<int, double> result = GetMatchedCRTTrackIdAndScore(tpcTrack, hits, crtTracks);
   return result.first;
 }
 
-std::pair<int,double> CRTTrackMatchAlg::GetMatchedCRTTrackIdAndScore(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event){
+int CRTTrackMatchAlg::GetMatchedCRTTrackId(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks) {
+  std::pair<int, double> result = GetMatchedCRTTrackIdAndScore(track, crtTracks);
+  return result.first;
+}
+
+std::pair<int,double> CRTTrackMatchAlg::GetMatchedCRTTrackIdAndScore(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event){
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return GetMatchedCRTTrackIdAndScore(tpcTrack, hits, crtTracks);
 }
 
+std::pair<int,double> CRTTrackMatchAlg::GetMatchedCRTTrackIdAndScore(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks) {
+  return GetMatchedCRTTrackIdAndScore(MakeTrackSummary(tpcTrack, hits), crtTracks);
+}
+
 // Find the closest valid matching CRT track ID
-std::pair<int,double> CRTTrackMatchAlg::GetMatchedCRTTrackIdAndScore(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks) {
+std::pair<int,double> CRTTrackMatchAlg::GetMatchedCRTTrackIdAndScore(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks) {
 
   std::pair<int, double> null = std::make_pair(-99999, -99999);
 
-  std::pair<crt::CRTTrack, double> closest;
+  std::pair<int, double> closest;
   if(fSelectionMetric == "angle"){ 
-    closest = ClosestCRTTrackByAngle(tpcTrack, hits, crtTracks);
+    closest = BestCRTTrackByAngle(track, crtTracks, 0.);
     if(closest.second == -99999 || closest.second > fMaxAngleDiff) return null;
   }
   else if(fSelectionMetric == "dca"){ 
-    closest = ClosestCRTTrackByDCA(tpcTrack, hits, crtTracks);
+    closest = BestCRTTrackByDCA(track, crtTracks, 0.);
     if(closest.second == -99999 || closest.second > fMaxDistance) return null;
   }
   else{
-    closest = ClosestCRTTrackByScore(tpcTrack, hits, crtTracks);
+    closest = BestCRTTrackByScore(track, crtTracks);
     if(closest.second == -99999 || closest.second > fMaxScore) return null;
   }
 
-  int crt_i = 0;
-  for(auto const& track : crtTracks){
-    if(fCrtBackTrack.TrackCompare(closest.first, track)) return std::make_pair(crt_i, closest.second);
-    crt_i++;
+  // Return the first CRT track identical to the best one
+  for(int crt_i = 0; crt_i < closest.first; crt_i++){
+    if(fCrtBackTrack.TrackCompare(crtTracks[closest.first], crtTracks[crt_i])) return std::make_pair(crt_i, closest.second);
   }
 
-  return null;
+  return closest;
 
 }
 
-std::vector<crt::CRTTrack> CRTTrackMatchAlg::AllPossibleCRTTracks(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event){
+std::vector<crt::CRTTrack> CRTTrackMatchAlg::AllPossibleCRTTracks(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event){
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return AllPossibleCRTTracks(tpcTrack, hits, crtTracks); 
 }
 
+std::vector<crt::CRTTrack> CRTTrackMatchAlg::AllPossibleCRTTracks(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks) {
+  return AllPossibleCRTTracks(MakeTrackSummary(tpcTrack, hits), crtTracks);
+}
+
 
-// Get all CRT tracks that cross the right TPC within an allowed time
-std::vector<crt::CRTTrack> CRTTrackMatchAlg::AllPossibleCRTTracks(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks) {
+double CRTTrackMatchAlg::CRTTrackShift(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack) const{
+  double crtTime = ((double)(int)crtTrack.ts1_ns) * 1e-3; // [us]
+  return track.driftDirection * crtTime * fDetectorProperties->DriftVelocity();
+}
 
-   std::vector<crt::CRTTrack> trackCandidates;
 
-  // Get the hits associated with the tpc track
+bool CRTTrackMatchAlg::PossibleCRTTrack(const TPCGeoUtil::TrackSummary& track, const geo::TPCGeo& tpcGeo, const crt::CRTTrack& crtTrack, double shift){
 
-  // Get the drift direction (0 for stitched tracks)
-  int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+  // Check the track is fully contained in the TPC when shifted to the CRT track time
+  if(shift != 0){
+    geo::Point_t start(track.start.X() + shift, track.start.Y(), track.start.Z());
+    if(!TPCGeoUtil::InsideTPC(start, tpcGeo, 2.)) return false;
+    geo::Point_t end(track.end.X() + shift, track.end.Y(), track.end.Z());
+    if(!TPCGeoUtil::InsideTPC(end, tpcGeo, 2.)) return false;
+  }
 
-  // Get the TPC Geo object from the tpc track
-  geo::TPCID tpcID = hits[0]->WireID().asTPCID();
-  const geo::TPCGeo& tpcGeo = fGeometryService->GetElement(tpcID);
+  // Calculate the intersection points for that TPC, skip if it doesn't intersect
+  std::pair<TVector3, TVector3> intersection = TpcIntersection(tpcGeo, crtTrack);
+  return intersection.first.X() != -99999;
 
-  // Loop over the crt tracks
-  for(auto const& crtTrack : crtTracks){
-    // Calculate the intersection points for that TPC
-    std::pair<TVector3, TVector3> intersection = TpcIntersection(tpcGeo, crtTrack);
+}
 
-    // Skip if it doesn't intersect
-    if(intersection.first.X() == -99999) continue;
 
-    // Shift the track to the CRT track
-    double crtTime = ((double)(int)crtTrack.ts1_ns) * 1e-3; // [us]
-    double shift = driftDirection * crtTime * fDetectorProperties->DriftVelocity();
-    geo::Point_t start = tpcTrack.Vertex();
-    geo::Point_t end = tpcTrack.End();
-    start.SetX(start.X() + shift);
-    end.SetX(end.X() + shift);
+// Get all CRT tracks that cross the right TPC within an allowed time
+std::vector<crt::CRTTrack> CRTTrackMatchAlg::AllPossibleCRTTracks(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks) {
+
+  std::vector<crt::CRTTrack> trackCandidates;
 
-    // Check the track is fully contained in the TPC
-    if(!TPCGeoUtil::InsideTPC(start, tpcGeo, 2.) && shift != 0) continue;
-    if(!TPCGeoUtil::InsideTPC(end, tpcGeo, 2.) && shift != 0) continue;
+  // Need the TPC of the track hits
+  if(!track.tpcID.isValid) return trackCandidates;
 
+  // Get the TPC Geo object from the tpc track
+  const geo::TPCGeo& tpcGeo = fGeometryService->GetElement(track.tpcID);
+
+  for(auto const& crtTrack : crtTracks){
+    if(!PossibleCRTTrack(track, tpcGeo, crtTrack, CRTTrackShift(track, crtTrack))) continue;
     trackCandidates.push_back(crtTrack);
-    
   }
 
   return trackCandidates;
 }
 
-std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByAngle(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event, double minDCA){
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByAngle(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event, double minDCA){
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return ClosestCRTTrackByAngle(tpcTrack, hits, crtTracks, minDCA);
 }
 
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByAngle(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks, double minDCA){
+  return ClosestCRTTrackByAngle(MakeTrackSummary(tpcTrack, hits), crtTracks, minDCA);
+}
+
 // Find the closest matching crt track by angle between tracks within angle and DCA limits
-std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByAngle(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks, double minDCA){
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByAngle(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks, double minDCA){
 
-  // Get the drift direction (0 for stitched tracks)
-  int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+  std::pair<int, double> best = BestCRTTrackByAngle(track, crtTracks, minDCA);
+  if(best.first != -99999) return std::make_pair(crtTracks[best.first], best.second);
+
+  crt::CRTTrack crtTrack;
+  return std::make_pair(crtTrack, -99999);
+}
+
+std::pair<int, double> CRTTrackMatchAlg::BestCRTTrackByAngle(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks, double minDCA){
+
+  std::pair<int, double> best = std::make_pair(-99999, -99999);
+  if(!track.tpcID.isValid) return best;
+  const geo::TPCGeo& tpcGeo = fGeometryService->GetElement(track.tpcID);
 
-  std::vector<crt::CRTTrack> possTracks = AllPossibleCRTTracks(tpcTrack, hits, crtTracks);
+  if(minDCA == 0) minDCA = fMaxDistance;
 
-  std::vector<std::pair<crt::CRTTrack, double>> candidates;
-  for(auto const& possTrack : possTracks){
-    double angle = AngleBetweenTracks(tpcTrack, possTrack);
+  for(size_t i = 0; i < crtTracks.size(); i++){
+    const crt::CRTTrack& crtTrack = crtTracks[i];
+
+    // Only a smaller angle can replace the current best
+    double angle = AngleBetweenTracks(track, crtTrack);
+    if(best.first != -99999 && angle >= best.second) continue;
+
+    double shift = CRTTrackShift(track, crtTrack);
+    if(!PossibleCRTTrack(track, tpcGeo, crtTrack, shift)) continue;
 
     if(minDCA != -1){
-      if(minDCA == 0) minDCA = fMaxDistance;
-      double crtTime = ((double)(int)possTrack.ts1_ns) * 1e-3; // [us]
-      double shift = driftDirection * crtTime * fDetectorProperties->DriftVelocity();
-      double DCA = AveDCABetweenTracks(tpcTrack, possTrack, shift);
+      if(MinDCABetweenTracks(track, crtTrack, shift) > minDCA) continue;
+      double DCA;
+      if(!AveDCABetweenTracks(track, crtTrack, shift, minDCA, DCA)) continue;
       if(DCA > minDCA) continue;
     }
-      
-    candidates.push_back(std::make_pair(possTrack, angle));
-  }
 
-  std::sort(candidates.begin(), candidates.end(), [](auto& left, auto& right){
-            return left.second < right.second;});
-
-  if(candidates.size() > 0){
-    return candidates[0];
+    best = std::make_pair((int)i, angle);
   }
-  crt::CRTTrack track;
-  return std::make_pair(track, -99999);
+
+  return best;
 }
 
-std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByDCA(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event, double minAngle) {
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByDCA(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event, double minAngle) {
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return ClosestCRTTrackByDCA(tpcTrack, hits, crtTracks, minAngle); 
 }
 
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByDCA(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks, double minAngle){
+  return ClosestCRTTrackByDCA(MakeTrackSummary(tpcTrack, hits), crtTracks, minAngle);
+}
+
 // Find the closest matching crt track by average DCA between tracks within angle and DCA limits
-std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByDCA(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks,  double minAngle){
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByDCA(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks, double minAngle){
 
-  // Get the drift direction (0 for stitched tracks)
-  int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+  std::pair<int, double> best = BestCRTTrackByDCA(track, crtTracks, minAngle);
+  if(best.first != -99999) return std::make_pair(crtTracks[best.first], best.second);
 
-  std::vector<crt::CRTTrack> possTracks = AllPossibleCRTTracks(tpcTrack, hits, crtTracks);
+  crt::CRTTrack crtTrack;
+  return std::make_pair(crtTrack, -99999);
 
-  std::vector<std::pair<crt::CRTTrack, double>> candidates;
-  for(auto const& possTrack : possTracks){
+}
 
-    double crtTime = ((double)(int)possTrack.ts1_ns) * 1e-3; // [us]
-    double shift = driftDirection * crtTime * fDetectorProperties->DriftVelocity();
+std::pair<int, double> CRTTrackMatchAlg::BestCRTTrackByDCA(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks, double minAngle){
 
-    double DCA = AveDCABetweenTracks(tpcTrack, possTrack, shift);
+  std::pair<int, double> best = std::make_pair(-99999, -99999);
+  if(!track.tpcID.isValid) return best;
+  const geo::TPCGeo& tpcGeo = fGeometryService->GetElement(track.tpcID);
 
-    if(minAngle != -1){
-      if(minAngle == 0) minAngle = fMaxAngleDiff;
-      double angle = AngleBetweenTracks(tpcTrack, possTrack);
-      if(angle > minAngle) continue;
-    }
-    candidates.push_back(std::make_pair(possTrack, DCA));
-  }
+  if(minAngle == 0) minAngle = fMaxAngleDiff;
+
+  for(size_t i = 0; i < crtTracks.size(); i++){
+    const crt::CRTTrack& crtTrack = crtTracks[i];
 
-  std::sort(candidates.begin(), candidates.end(), [](auto& left, auto& right){
-            return left.second < right.second;});
+    if(minAngle != -1 && AngleBetweenTracks(track, crtTrack) > minAngle) continue;
 
-  if(candidates.size() > 0){
-    return candidates[0];
+    double shift = CRTTrackShift(track, crtTrack);
+    if(!PossibleCRTTrack(track, tpcGeo, crtTrack, shift)) continue;
+
+    // Only a smaller DCA can replace the current best
+    double limit = std::numeric_limits<double>::max();
+    if(best.first != -99999){
+      limit = best.second;
+      if(MinDCABetweenTracks(track, crtTrack, shift) >= limit) continue;
+    }
+    double DCA;
+    if(!AveDCABetweenTracks(track, crtTrack, shift, limit, DCA)) continue;
+    if(best.first != -99999 && DCA >= best.second) continue;
+
+    best = std::make_pair((int)i, DCA);
   }
-  crt::CRTTrack track;
-  return std::make_pair(track, -99999);
 
-}
+  return best;
 
+}
 
-std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByScore(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event) {
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByScore(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event) {
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return ClosestCRTTrackByScore(tpcTrack, hits, crtTracks); 
 }
 
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByScore(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks){
+  return ClosestCRTTrackByScore(MakeTrackSummary(tpcTrack, hits), crtTracks);
+}
+
 // Find the closest matching crt track by average DCA between tracks within angle and DCA limits
-std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByScore(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks){
+std::pair<crt::CRTTrack, double> CRTTrackMatchAlg::ClosestCRTTrackByScore(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks){
 
-  // Get the drift direction (0 for stitched tracks)
-  int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+  std::pair<int, double> best = BestCRTTrackByScore(track, crtTracks);
+  if(best.first != -99999) return std::make_pair(crtTracks[best.first], best.second);
 
-  std::vector<crt::CRTTrack> possTracks = AllPossibleCRTTracks(tpcTrack, hits, crtTracks);
+  crt::CRTTrack crtTrack;
+  return std::make_pair(crtTrack, -99999);
 
-  std::vector<std::pair<crt::CRTTrack, double>> candidates;
-  for(auto const& possTrack : possTracks){
+}
 
-    double crtTime = ((double)(int)possTrack.ts1_ns) * 1e-3; // [us]
-    double shift = driftDirection * crtTime * fDetectorProperties->DriftVelocity();
+std::pair<int, double> CRTTrackMatchAlg::BestCRTTrackByScore(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks){
 
-    double DCA = AveDCABetweenTracks(tpcTrack, possTrack, shift);
-    double angle = AngleBetweenTracks(tpcTrack, possTrack);
-    double score = DCA + 4*180/TMath::Pi()*angle;
+  std::pair<int, double> best = std::make_pair(-99999, -99999);
+  if(!track.tpcID.isValid) return best;
+  const geo::TPCGeo& tpcGeo = fGeometryService->GetElement(track.tpcID);
 
-    candidates.push_back(std::make_pair(possTrack, score));
-  }
+  for(size_t i = 0; i < crtTracks.size(); i++){
+    const crt::CRTTrack& crtTrack = crtTracks[i];
+
+    // The DCA can only add to the angle part of the score
+    double angleScore = 4*180/TMath::Pi()*AngleBetweenTracks(track, crtTrack);
+    if(best.first != -99999 && angleScore >= best.second) continue;
 
-  std::sort(candidates.begin(), candidates.end(), [](auto& left, auto& right){
-            return left.second < right.second;});
+    double shift = CRTTrackShift(track, crtTrack);
+    if(!PossibleCRTTrack(track, tpcGeo, crtTrack, shift)) continue;
 
-  if(candidates.size() > 0){
-    return candidates[0];
+    double limit = std::numeric_limits<double>::max();
+    if(best.first != -99999){
+      limit = best.second - angleScore;
+      if(MinDCABetweenTracks(track, crtTrack, shift) >= limit) continue;
+    }
+    double DCA;
+    if(!AveDCABetweenTracks(track, crtTrack, shift, limit, DCA)) continue;
+    double score = DCA + angleScore;
+    if(best.first != -99999 && score >= best.second) continue;
+
+    best = std::make_pair((int)i, score);
   }
-  crt::CRTTrack track;
-  return std::make_pair(track, -99999);
+
+  return best;
 
 }
 
 
 // Calculate the angle between tracks assuming start is at the largest Y
-double CRTTrackMatchAlg::AngleBetweenTracks(recob::Track tpcTrack, crt::CRTTrack crtTrack){
+double CRTTrackMatchAlg::AngleBetweenTracks(const recob::Track& tpcTrack, const crt::CRTTrack& crtTrack){
+  return AngleBetweenTracks(tpcTrack.Vertex<TVector3>(), tpcTrack.End<TVector3>(), crtTrack);
+}
+
+double CRTTrackMatchAlg::AngleBetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack){
+  return AngleBetweenTracks(track.start, track.end, crtTrack);
+}
+
+double CRTTrackMatchAlg::AngleBetweenTracks(TVector3 tpcStart, TVector3 tpcEnd, const crt::CRTTrack& crtTrack) const{
 
   // Calculate the angle between the tracks
   TVector3 crtStart (crtTrack.x1_pos, crtTrack.y1_pos, crtTrack.z1_pos);
   TVector3 crtEnd (crtTrack.x2_pos, crtTrack.y2_pos, crtTrack.z2_pos);
   if(crtStart.Y() < crtEnd.Y()) std::swap(crtStart, crtEnd);
 
-  TVector3 tpcStart = tpcTrack.Vertex<TVector3>();
-  TVector3 tpcEnd  = tpcTrack.End<TVector3>();
   if(tpcStart.Y() < tpcEnd.Y()) std::swap(tpcStart, tpcEnd);
 
   return (tpcStart - tpcEnd).Angle(crtStart - crtEnd);
@@ -347,70 +419,80 @@ double CRTTrackMatchAlg::AngleBetweenTracks(recob::Track tpcTrack, crt::CRTTrack
 }
 
 
+double CRTTrackMatchAlg::AveDCABetweenTracks(const recob::Track& tpcTrack, const crt::CRTTrack& crtTrack, double shift){
+  return AveDCABetweenTracks(MakeTrackSummary(tpcTrack, {}), crtTrack, shift);
+}
+
 // Calculate the average DCA between tracks
-double CRTTrackMatchAlg::AveDCABetweenTracks(recob::Track tpcTrack, crt::CRTTrack crtTrack, double shift){
+double CRTTrackMatchAlg::AveDCABetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack, double shift){
+
+  double aveDCA = 0;
+  AveDCABetweenTracks(track, crtTrack, shift, std::numeric_limits<double>::max(), aveDCA);
+  return aveDCA;
+
+}
+
+bool CRTTrackMatchAlg::AveDCABetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack, double shift, 
+                                           double limit, double& aveDCA) const{
 
   TVector3 crtStart (crtTrack.x1_pos, crtTrack.y1_pos, crtTrack.z1_pos);
   TVector3 crtEnd (crtTrack.x2_pos, crtTrack.y2_pos, crtTrack.z2_pos);
   if(crtStart.Y() < crtEnd.Y()) std::swap(crtStart, crtEnd);
   double denominator = (crtEnd - crtStart).Mag();
 
-  size_t npts = tpcTrack.NumberTrajectoryPoints();
+  size_t npts = track.x.size();
 
-  double aveDCA = 0;
-  int usedPts = 0;
+  // Every term is positive so the final average can't be below the running sum over all points
+  double sumDCA = 0;
   for(size_t i = 0; i < npts; i++){
-    TVector3 point = tpcTrack.LocationAtPoint<TVector3>(i);
+    TVector3 point(track.x[i] + shift, track.y[i], track.z[i]);
+    sumDCA += (point - crtStart).Cross(point - crtEnd).Mag()/denominator;
+    if(sumDCA/npts > limit){
+      aveDCA = sumDCA/npts;
+      return false;
+    }
+  }
 
-    // Pandora produces dummy points
-    if(!tpcTrack.HasValidPoint(i)) continue;
+  aveDCA = sumDCA/npts;
+  return true;
 
-    point.SetX(point.X() + shift);
-    aveDCA += (point - crtStart).Cross(point - crtEnd).Mag()/denominator;
-    usedPts++;
-  }
+}
+
+double CRTTrackMatchAlg::MinDCABetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack, double shift) const{
 
-  return aveDCA/usedPts;
+  if(track.x.size() == 0) return 0;
+
+  TVector3 crtStart (crtTrack.x1_pos, crtTrack.y1_pos, crtTrack.z1_pos);
+  TVector3 crtEnd (crtTrack.x2_pos, crtTrack.y2_pos, crtTrack.z2_pos);
+
+  // No point in the box can be closer than the distance to its centre minus half the diagonal,
+  // minus a little extra to stay clear of rounding in the full calculation
+  TVector3 centre = 0.5*(track.min + track.max);
+  centre.SetX(centre.X() + shift);
+  double radius = 0.5*(track.max - track.min).Mag();
+  double centreDCA = (centre - crtStart).Cross(centre - crtEnd).Mag()/(crtEnd - crtStart).Mag();
+
+  return std::max(0., centreDCA - radius - 1e-3);
 
 }
 
-double CRTTrackMatchAlg::AveDCABetweenTracks(recob::Track tpcTrack, crt::CRTTrack crtTrack, const art::Event& event) {
+double CRTTrackMatchAlg::AveDCABetweenTracks(const recob::Track& tpcTrack, const crt::CRTTrack& crtTrack, const art::Event& event) {
   auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
   art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = findManyHits.at(tpcTrack.ID());
   return AveDCABetweenTracks(tpcTrack, hits, crtTrack);
 }
 
 
 // Calculate the average DCA between tracks
-double CRTTrackMatchAlg::AveDCABetweenTracks(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, crt::CRTTrack crtTrack) {
+double CRTTrackMatchAlg::AveDCABetweenTracks(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const crt::CRTTrack& crtTrack) {
 
   // Get the drift direction (0 for stitched tracks)
-  int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+  TPCGeoUtil::TrackSummary track = MakeTrackSummary(tpcTrack, hits);
   double crtTime = ((double)(int)crtTrack.ts1_ns) * 1e-3; // [us]
-  double shift = driftDirection * crtTime * fDetectorProperties->DriftVelocity();
-
-  TVector3 crtStart (crtTrack.x1_pos, crtTrack.y1_pos, crtTrack.z1_pos);
-  TVector3 crtEnd (crtTrack.x2_pos, crtTrack.y2_pos, crtTrack.z2_pos);
-  if(crtStart.Y() < crtEnd.Y()) std::swap(crtStart, crtEnd);
-  double denominator = (crtEnd - crtStart).Mag();
-
-  size_t npts = tpcTrack.NumberTrajectoryPoints();
-
-  double aveDCA = 0;
-  int usedPts = 0;
-  for(size_t i = 0; i < npts; i++){
-    TVector3 point = tpcTrack.LocationAtPoint<TVector3>(i);
-
-    // Pandora produces dummy points
-    if(!tpcTrack.HasValidPoint(i)) continue;
-
-    point.SetX(point.X() + shift);
-    aveDCA += (point - crtStart).Cross(point - crtEnd).Mag()/denominator;
-    usedPts++;
-  }
+  double shift = track.driftDirection * crtTime * fDetectorProperties->DriftVelocity();
 
-  return aveDCA/usedPts;
+  return AveDCABetweenTracks(track, crtTrack, shift);
 
 }
 
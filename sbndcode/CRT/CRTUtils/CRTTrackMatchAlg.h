@@ -106,71 +106,112 @@ namespace sbnd{
     void reconfigure(const Config& config);
 
     // Calculate intersection between CRT track and TPC
-    std::pair<TVector3, TVector3> TpcIntersection(const geo::TPCGeo& tpcGeo, crt::CRTTrack track);
+    std::pair<TVector3, TVector3> TpcIntersection(const geo::TPCGeo& tpcGeo, const crt::CRTTrack& track);
 
     // Function to calculate if a CRTTrack crosses the TPC volume
-    bool CrossesTPC(crt::CRTTrack track);
+    bool CrossesTPC(const crt::CRTTrack& track);
 
     // Function to calculate if a CRTTrack crosses the TPC volume
     bool CrossesAPA(crt::CRTTrack track);
 
-    double T0FromCRTTracks(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event);
-    double T0FromCRTTracks(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks);
+    // Summarise the track geometry once, can be reused for every matching call on the same track
+    TPCGeoUtil::TrackSummary MakeTrackSummary(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits) const;
+
+    double T0FromCRTTracks(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event);
+    double T0FromCRTTracks(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks);
+    double T0FromCRTTracks(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks);
 
     // Find the closest valid matching CRT track ID
-    int GetMatchedCRTTrackId(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event);
-    int GetMatchedCRTTrackId(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks);
+    int GetMatchedCRTTrackId(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event);
+    int GetMatchedCRTTrackId(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks);
+    int GetMatchedCRTTrackId(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks);
 
     // Find the closest valid matching CRT track ID and return the minimised matching metric
-    std::pair<int,double> GetMatchedCRTTrackIdAndScore(recob::Track tpcTrack, std::vector<crt::CRTTrack> crtTracks, const art::Event& event);
-    std::pair<int,double> GetMatchedCRTTrackIdAndScore(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, std::vector<crt::CRTTrack> crtTracks);
+    std::pair<int,double> GetMatchedCRTTrackIdAndScore(const recob::Track& tpcTrack, const std::vector<crt::CRTTrack>& crtTracks, const art::Event& event);
+    std::pair<int,double> GetMatchedCRTTrackIdAndScore(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks);
+    std::pair<int,double> GetMatchedCRTTrackIdAndScore(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks);
 
     // Get all CRT tracks that cross the right TPC within an allowed time
-    std::vector<crt::CRTTrack> AllPossibleCRTTracks(recob::Track tpcTrack, 
-                                                    std::vector<crt::CRTTrack> crtTracks, 
+    std::vector<crt::CRTTrack> AllPossibleCRTTracks(const recob::Track& tpcTrack, 
+                                                    const std::vector<crt::CRTTrack>& crtTracks, 
                                                     const art::Event& event); 
 
-    std::vector<crt::CRTTrack> AllPossibleCRTTracks(recob::Track tpcTrack, 
-                                                    std::vector<art::Ptr<recob::Hit>> hits,
-                                                    std::vector<crt::CRTTrack> crtTracks);
+    std::vector<crt::CRTTrack> AllPossibleCRTTracks(const recob::Track& tpcTrack, 
+                                                    const std::vector<art::Ptr<recob::Hit>>& hits,
+                                                    const std::vector<crt::CRTTrack>& crtTracks);
+    std::vector<crt::CRTTrack> AllPossibleCRTTracks(const TPCGeoUtil::TrackSummary& track, 
+                                                    const std::vector<crt::CRTTrack>& crtTracks);
 
     // Find the closest matching crt track by angle between tracks within angle and DCA limits
-    std::pair<crt::CRTTrack, double> ClosestCRTTrackByAngle(recob::Track tpcTrack, 
-                                                            std::vector<crt::CRTTrack> crtTracks, 
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByAngle(const recob::Track& tpcTrack, 
+                                                            const std::vector<crt::CRTTrack>& crtTracks, 
                                                             const art::Event& event,
                                                             double minDCA = 0.); 
-    std::pair<crt::CRTTrack, double> ClosestCRTTrackByAngle(recob::Track tpcTrack, 
-                                                            std::vector<art::Ptr<recob::Hit>> hits, 
-                                                            std::vector<crt::CRTTrack> crtTracks, 
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByAngle(const recob::Track& tpcTrack, 
+                                                            const std::vector<art::Ptr<recob::Hit>>& hits, 
+                                                            const std::vector<crt::CRTTrack>& crtTracks, 
+                                                            double minDCA = 0.); 
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByAngle(const TPCGeoUtil::TrackSummary& track, 
+                                                            const std::vector<crt::CRTTrack>& crtTracks, 
                                                             double minDCA = 0.); 
     // Find the closest matching crt track by average DCA between tracks within angle and DCA limits
-    std::pair<crt::CRTTrack, double> ClosestCRTTrackByDCA(recob::Track tpcTrack, 
-                                                          std::vector<crt::CRTTrack> crtTracks, 
-							                                            const art::Event& event,
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByDCA(const recob::Track& tpcTrack, 
+                                                          const std::vector<crt::CRTTrack>& crtTracks, 
+                                                          const art::Event& event,
+                                                          double minAngle = 0.); 
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByDCA(const recob::Track& tpcTrack, 
+                                                          const std::vector<art::Ptr<recob::Hit>>& hits, 
+                                                          const std::vector<crt::CRTTrack>& crtTracks, 
                                                           double minAngle = 0.); 
-    std::pair<crt::CRTTrack, double> ClosestCRTTrackByDCA(recob::Track tpcTrack, 
-                                                          std::vector<art::Ptr<recob::Hit>> hits, 
-                                                          std::vector<crt::CRTTrack> crtTracks, 
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByDCA(const TPCGeoUtil::TrackSummary& track, 
+                                                          const std::vector<crt::CRTTrack>& crtTracks, 
                                                           double minAngle = 0.); 
     // Find the closest matching crt track by average DCA between tracks within angle and DCA limits
-    std::pair<crt::CRTTrack, double> ClosestCRTTrackByScore(recob::Track tpcTrack, 
-                                                          std::vector<crt::CRTTrack> crtTracks, 
-							                                            const art::Event& event); 
-    std::pair<crt::CRTTrack, double> ClosestCRTTrackByScore(recob::Track tpcTrack, 
-                                                          std::vector<art::Ptr<recob::Hit>> hits, 
-                                                          std::vector<crt::CRTTrack> crtTracks);
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByScore(const recob::Track& tpcTrack, 
+                                                          const std::vector<crt::CRTTrack>& crtTracks, 
+                                                          const art::Event& event); 
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByScore(const recob::Track& tpcTrack, 
+                                                          const std::vector<art::Ptr<recob::Hit>>& hits, 
+                                                          const std::vector<crt::CRTTrack>& crtTracks);
+    std::pair<crt::CRTTrack, double> ClosestCRTTrackByScore(const TPCGeoUtil::TrackSummary& track, 
+                                                          const std::vector<crt::CRTTrack>& crtTracks);
 
     // Calculate the angle between tracks assuming start is at the largest Y
-    double AngleBetweenTracks(recob::Track tpcTrack, crt::CRTTrack crtTrack);
+    double AngleBetweenTracks(const recob::Track& tpcTrack, const crt::CRTTrack& crtTrack);
+    double AngleBetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack);
 
     // Calculate the average DCA between tracks
-    double AveDCABetweenTracks(recob::Track tpcTrack, crt::CRTTrack crtTrack, double shift);
-    double AveDCABetweenTracks(recob::Track tpcTrack, crt::CRTTrack crtTrack, const art::Event& event);
-    double AveDCABetweenTracks(recob::Track tpcTrack, std::vector<art::Ptr<recob::Hit>> hits, crt::CRTTrack crtTrack);
+    double AveDCABetweenTracks(const recob::Track& tpcTrack, const crt::CRTTrack& crtTrack, double shift);
+    double AveDCABetweenTracks(const recob::Track& tpcTrack, const crt::CRTTrack& crtTrack, const art::Event& event);
+    double AveDCABetweenTracks(const recob::Track& tpcTrack, const std::vector<art::Ptr<recob::Hit>>& hits, const crt::CRTTrack& crtTrack);
+    double AveDCABetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack, double shift);
+
+    // Drift shift of the TPC track for the time of the CRT track
+    double CRTTrackShift(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack) const;
 
   private:
 
+    // Staged matching, cheap bounds are checked before the full average DCA and only the best
+    // candidate is kept. Returns the index of the best CRT track and its metric, -99999 if none
+    std::pair<int, double> BestCRTTrackByAngle(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks, double minDCA);
+    std::pair<int, double> BestCRTTrackByDCA(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks, double minAngle);
+    std::pair<int, double> BestCRTTrackByScore(const TPCGeoUtil::TrackSummary& track, const std::vector<crt::CRTTrack>& crtTracks);
+
+    // Check the CRT track crosses the TPC and the shifted TPC track stays inside it, containment is checked first
+    bool PossibleCRTTrack(const TPCGeoUtil::TrackSummary& track, const geo::TPCGeo& tpcGeo, const crt::CRTTrack& crtTrack, double shift);
+
+    // Angle between the TPC track from its end points and the CRT track
+    double AngleBetweenTracks(TVector3 tpcStart, TVector3 tpcEnd, const crt::CRTTrack& crtTrack) const;
+
+    // Lower bound on the DCA of any track point to the CRT track from the bounding box of the points
+    double MinDCABetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack, double shift) const;
+
+    // Average DCA between tracks, gives up and returns false as soon as the average must exceed limit
+    bool AveDCABetweenTracks(const TPCGeoUtil::TrackSummary& track, const crt::CRTTrack& crtTrack, double shift, 
+                             double limit, double& aveDCA) const;
+
     geo::GeometryCore const* fGeometryService;
+    TPCGeoUtil::TPCDriftTable fTPCDriftTable;
     detinfo::DetectorProperties const* fDetectorProperties;
 
     CRTBackTracker fCrtBackTrack;
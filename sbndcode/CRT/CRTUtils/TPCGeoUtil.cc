@@ -1,8 +1,11 @@
 #include "TPCGeoUtil.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace sbnd {
 namespace TPCGeoUtil {
-int DetectedInTPC(std::vector<art::Ptr<recob::Hit>> hits){
+int DetectedInTPC(const std::vector<art::Ptr<recob::Hit>>& hits){
   // Return tpc of hit collection or -1 if in multiple
   if(hits.size() == 0) return -1;
   int tpc = hits[0]->WireID().TPC;
@@ -12,7 +15,7 @@ int DetectedInTPC(std::vector<art::Ptr<recob::Hit>> hits){
   return tpc;
 }
 // Work out the drift limits for a collection of hits
-std::pair<double, double> XLimitsFromHits(const geo::GeometryCore *GeometryService, std::vector<art::Ptr<recob::Hit>> hits){
+std::pair<double, double> XLimitsFromHits(const geo::GeometryCore *GeometryService, const std::vector<art::Ptr<recob::Hit>>& hits){
   // If there are no hits then return 0
   if(hits.size() == 0) return std::make_pair(0, 0);
   
@@ -25,7 +28,7 @@ std::pair<double, double> XLimitsFromHits(const geo::GeometryCore *GeometryServi
   return std::make_pair(tpcGeo.MinX(), tpcGeo.MaxX());
 }
 
-int DriftDirectionFromHits(const geo::GeometryCore *GeometryService, std::vector<art::Ptr<recob::Hit>> hits){
+int DriftDirectionFromHits(const geo::GeometryCore *GeometryService, const std::vector<art::Ptr<recob::Hit>>& hits){
   // If there are no hits then return 0
   if(hits.size() == 0) return 0;
   
@@ -40,6 +43,26 @@ int DriftDirectionFromHits(const geo::GeometryCore *GeometryService, std::vector
   return driftDirection;
 }
 
+// Same as above from the cached table
+std::pair<double, double> XLimitsFromHits(const TPCDriftTable& driftTable, const std::vector<art::Ptr<recob::Hit>>& hits){
+  // If there are no hits or the track is stitched return 0
+  if(hits.size() == 0) return std::make_pair(0, 0);
+  if(DetectedInTPC(hits) == -1) return std::make_pair(0, 0);
+
+  const geo::WireID& wireID = hits[0]->WireID();
+  const TPCDriftInfo& info = driftTable.at(wireID.Cryostat).at(wireID.TPC);
+  return std::make_pair(info.minX, info.maxX);
+}
+
+int DriftDirectionFromHits(const TPCDriftTable& driftTable, const std::vector<art::Ptr<recob::Hit>>& hits){
+  // If there are no hits or the track is stitched return 0
+  if(hits.size() == 0) return 0;
+  if(DetectedInTPC(hits) == -1) return 0;
+
+  const geo::WireID& wireID = hits[0]->WireID();
+  return driftTable.at(wireID.Cryostat).at(wireID.TPC).driftDirection;
+}
+
 // Is point inside given TPC
 bool InsideTPC(geo::Point_t point, const geo::TPCGeo& tpc, double buffer){
   if(point.X() < (tpc.MinX()-buffer) || point.X() > (tpc.MaxX()+buffer)
@@ -48,5 +71,78 @@ bool InsideTPC(geo::Point_t point, const geo::TPCGeo& tpc, double buffer){
   return true;
 }
 
+// Calculate direction as an average over directions
+std::pair<TVector3, TVector3> TrackDirectionAverage(const recob::Track& track, double frac){
+
+  size_t nTrackPoints = track.NumberTrajectoryPoints();
+  const recob::TrackTrajectory& trajectory = track.Trajectory();
+  std::vector<geo::Vector_t> validDirections;
+  validDirections.reserve(nTrackPoints);
+  for(size_t i = 0; i < nTrackPoints; i++){
+    if(trajectory.FlagsAtPoint(i)!=recob::TrajectoryPointFlags::InvalidHitIndex) continue;
+    validDirections.push_back(track.DirectionAtPoint(i));
+  }
+
+  size_t nValidPoints = validDirections.size();
+  int endPoint = (int)floor(nValidPoints*frac);
+  double xTotStart = 0; double yTotStart = 0; double zTotStart = 0;
+  double xTotEnd = 0; double yTotEnd = 0; double zTotEnd = 0;
+  for(int i = 0; i < endPoint; i++){
+    const geo::Vector_t& dirStart = validDirections[i];
+    const geo::Vector_t& dirEnd = validDirections[nValidPoints - (i+1)];
+    xTotStart += dirStart.X();
+    yTotStart += dirStart.Y();
+    zTotStart += dirStart.Z();
+    xTotEnd += dirEnd.X();
+    yTotEnd += dirEnd.Y();
+    zTotEnd += dirEnd.Z();
+  }
+  TVector3 startDir = {-xTotStart/endPoint, -yTotStart/endPoint, -zTotStart/endPoint};
+  TVector3 endDir = {xTotEnd/endPoint, yTotEnd/endPoint, zTotEnd/endPoint};
+
+  return std::make_pair(startDir, endDir);
+}
+
+// Walk the trajectory once and keep what the CRT matching uses
+TrackSummary MakeTrackSummary(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, 
+                              const TPCDriftTable& driftTable, double directionFrac){
+  TrackSummary summary;
+  summary.length = track.Length();
+  summary.start = track.Vertex<TVector3>();
+  summary.end = track.End<TVector3>();
+
+  if(directionFrac > 0){
+    std::pair<TVector3, TVector3> startEndDir = TrackDirectionAverage(track, directionFrac);
+    summary.startDir = startEndDir.first;
+    summary.endDir = startEndDir.second;
+  }
+
+  size_t npts = track.NumberTrajectoryPoints();
+  summary.x.reserve(npts);
+  summary.y.reserve(npts);
+  summary.z.reserve(npts);
+  for(size_t i = 0; i < npts; i++){
+    // Pandora produces dummy points
+    if(!track.HasValidPoint(i)) continue;
+    const geo::Point_t& point = track.LocationAtPoint(i);
+    summary.x.push_back(point.X());
+    summary.y.push_back(point.Y());
+    summary.z.push_back(point.Z());
+  }
+  if(summary.x.size() > 0){
+    auto xLim = std::minmax_element(summary.x.begin(), summary.x.end());
+    auto yLim = std::minmax_element(summary.y.begin(), summary.y.end());
+    auto zLim = std::minmax_element(summary.z.begin(), summary.z.end());
+    summary.min.SetXYZ(*xLim.first, *yLim.first, *zLim.first);
+    summary.max.SetXYZ(*xLim.second, *yLim.second, *zLim.second);
+  }
+
+  if(hits.size() > 0) summary.tpcID = hits[0]->WireID().asTPCID();
+  summary.driftDirection = DriftDirectionFromHits(driftTable, hits);
+  summary.xLimits = XLimitsFromHits(driftTable, hits);
+
+  return summary;
+}
+
 } // namespace TPCGeoUtil
 } // namespace sbnd
@@ -15,18 +15,55 @@
 #include "larcorealg/Geometry/GeometryCore.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
 #include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/Track.h"
+
+// sbndcode
+#include "sbndcode/Geometry/GeometryWrappers/TPCDriftTable.h"
 
 // c++
 #include <vector>
+#include <utility>
+
+// ROOT
+#include "TVector3.h"
 
 namespace sbnd {
 namespace TPCGeoUtil {
-  int DetectedInTPC(std::vector<art::Ptr<recob::Hit>> hits);
+  int DetectedInTPC(const std::vector<art::Ptr<recob::Hit>>& hits);
   // Work out the drift limits for a collection of hits
-  std::pair<double, double> XLimitsFromHits(const geo::GeometryCore *GeometryService, std::vector<art::Ptr<recob::Hit>> hits);
+  std::pair<double, double> XLimitsFromHits(const geo::GeometryCore *GeometryService, const std::vector<art::Ptr<recob::Hit>>& hits);
+  std::pair<double, double> XLimitsFromHits(const TPCDriftTable& driftTable, const std::vector<art::Ptr<recob::Hit>>& hits);
   // Is point inside given TPC
   bool InsideTPC(geo::Point_t point, const geo::TPCGeo& tpc, double buffer);
-  int DriftDirectionFromHits(const geo::GeometryCore *GeometryService, std::vector<art::Ptr<recob::Hit>> hits);
+  int DriftDirectionFromHits(const geo::GeometryCore *GeometryService, const std::vector<art::Ptr<recob::Hit>>& hits);
+  int DriftDirectionFromHits(const TPCDriftTable& driftTable, const std::vector<art::Ptr<recob::Hit>>& hits);
+
+  // Everything the CRT matching needs to know about a TPC track, build once per track and
+  // pass by reference instead of walking the trajectory for every CRT candidate
+  struct TrackSummary {
+    double length = 0;
+    TVector3 start;
+    TVector3 end;
+    // Directions averaged over the start and end of the track, both pointing outwards
+    TVector3 startDir;
+    TVector3 endDir;
+    // Valid trajectory points (Pandora produces dummy points) stored per coordinate
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    // Bounding box of the valid points
+    TVector3 min;
+    TVector3 max;
+    // TPC of the first hit, drift direction and drift limits (0 for stitched tracks)
+    geo::TPCID tpcID;
+    int driftDirection = 0;
+    std::pair<double, double> xLimits = std::make_pair(0, 0);
+  };
+  // Average the directions at the first and last fraction of valid trajectory points
+  std::pair<TVector3, TVector3> TrackDirectionAverage(const recob::Track& track, double frac);
+  // Directions are only averaged if directionFrac > 0
+  TrackSummary MakeTrackSummary(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, 
+                                const TPCDriftTable& driftTable, double directionFrac);
 } // namespace TPCGeoUtil
 } // namespace sbnd
 #endif
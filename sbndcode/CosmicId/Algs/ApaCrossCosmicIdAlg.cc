@@ -34,8 +34,38 @@ void ApaCrossCosmicIdAlg::reconfigure(const Config& config){
 }
 
 
+// Sort a list of flash times for the crossing search
+ApaCrossCosmicIdAlg::FlashTimeIndex ApaCrossCosmicIdAlg::MakeFlashTimeIndex(const std::vector<double>& t0List){
+
+  // If particle crosses the APA before t = 0 the crossing point won't be reconstructed
+  std::vector<std::pair<double, size_t>> sorted;
+  for(size_t i = 0; i < t0List.size(); i++){
+    if(t0List[i] >= 0) sorted.push_back(std::make_pair(t0List[i], i));
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  // Repeated times give the same distance so only the first in the list is needed
+  FlashTimeIndex t0Index;
+  for(auto const& t0 : sorted){
+    if(!t0Index.times.empty() && t0Index.times.back() == t0.first) continue;
+    t0Index.times.push_back(t0.first);
+    t0Index.listIndex.push_back(t0.second);
+  }
+
+  return t0Index;
+
+}
+
+
 // Get the minimum distance from track to APA for different times
-std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(recob::Track track, std::vector<double> t0List, int tpc){
+std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(const recob::Track& track, const std::vector<double>& t0List, int tpc) const{
+
+  return MinApaDistance(track, MakeFlashTimeIndex(t0List), tpc);
+
+}
+
+
+std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(const recob::Track& track, const FlashTimeIndex& t0Index, int tpc) const{
 
   double crossTime = -99999;
   double xmax = fTpcGeo.MaxX();
@@ -58,22 +88,42 @@ std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(recob::Track track
   // If in both TPCs (stitched) return null values
   if(tpc == -1) return std::make_pair(minDist, crossTime);
 
-  // Shift track by all t0's
-  for(auto const& t0 : t0List){
-    // If particle crosses the APA before t = 0 the crossing point won't be reconstructed
-    if(t0 < 0) continue;
-    double shiftedX = point.X();
-    double shift = t0 * fDetectorProperties->DriftVelocity();
-    if(tpc == 0) shiftedX = point.X() - shift;
-    if(tpc == 1) shiftedX = point.X() + shift;
+  const std::vector<double>& times = t0Index.times;
+  if(times.empty()) return std::make_pair(minDist, crossTime);
+
+  double driftVelocity = fDetectorProperties->DriftVelocity();
+  double direction = 0;
+  if(tpc == 0) direction = -1;
+  if(tpc == 1) direction = 1;
+
+  // The distance is piecewise linear in time with minima where the shifted point is on the APA,
+  // so only the earliest time and the times either side of the crossing times need checking
+  std::vector<size_t> candidates {0};
+  if(direction != 0){
+    for(double apaX : {xmax, -xmax}){
+      double apaTime = (apaX - point.X()) / (direction * driftVelocity);
+      size_t i = std::lower_bound(times.begin(), times.end(), apaTime) - times.begin();
+      for(size_t j = (i > 2 ? i - 2 : 0); j < std::min(i + 2, times.size()); j++) candidates.push_back(j);
+    }
+  }
+  else{
+    // Shifting does nothing so every time is equally good, take the first in the list
+    for(size_t j = 1; j < times.size(); j++) candidates.push_back(j);
+  }
+
+  size_t bestIndex = 0;
+  for(auto const& j : candidates){
+    double shiftedX = point.X() + direction * times[j] * driftVelocity;
 
     //Check track still in TPC
     if(std::abs(shiftedX) > (xmax + fDistanceLimit)) continue;
     //Calculate distance between start/end and APA
     double dist = std::abs(std::abs(shiftedX) - xmax);
-    if(dist < minDist) {
+    // Keep the earliest in the original list if distances are equal
+    if(dist < minDist || (dist == minDist && crossTime != -99999 && t0Index.listIndex[j] < bestIndex)) {
       minDist = dist;
-      crossTime = t0;
+      crossTime = times[j];
+      bestIndex = t0Index.listIndex[j];
     }
   }
 
@@ -83,10 +133,17 @@ std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(recob::Track track
 
 
 // Get time by matching tracks which cross the APA
-double ApaCrossCosmicIdAlg::T0FromApaCross(recob::Track track, std::vector<double> t0List, int tpc){
+double ApaCrossCosmicIdAlg::T0FromApaCross(const recob::Track& track, const std::vector<double>& t0List, int tpc) const{
+
+  return T0FromApaCross(track, MakeFlashTimeIndex(t0List), tpc);
+
+}
+
+
+double ApaCrossCosmicIdAlg::T0FromApaCross(const recob::Track& track, const FlashTimeIndex& t0Index, int tpc) const{
 
   // Get the minimum distance to the APA and corresponding time
-  std::pair<double, double> min = MinApaDistance(track, t0List, tpc);
+  std::pair<double, double> min = MinApaDistance(track, t0Index, tpc);
   // Check the distance is within allowed limit
   if(min.first < fDistanceLimit) return min.second;
   return -99999;
@@ -95,7 +152,7 @@ double ApaCrossCosmicIdAlg::T0FromApaCross(recob::Track track, std::vector<doubl
 
 
 // Get the distance from track to APA at fixed time
-double ApaCrossCosmicIdAlg::ApaDistance(recob::Track track, double t0, std::vector<art::Ptr<recob::Hit>> hits){
+double ApaCrossCosmicIdAlg::ApaDistance(const recob::Track& track, double t0, const std::vector<art::Ptr<recob::Hit>>& hits) const{
 
   std::vector<double> t0List {t0};
   // Determine the TPC from hit collection
@@ -107,7 +164,7 @@ double ApaCrossCosmicIdAlg::ApaDistance(recob::Track track, double t0, std::vect
 }
 
 // Work out what TPC track is in and get the minimum distance from track to APA for different times
-std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(recob::Track track, std::vector<art::Ptr<recob::Hit>> hits, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1){
+std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1) const{
 
   // Determine the TPC from hit collection
   int tpc = fTpcGeo.DetectedInTPC(hits);
@@ -122,11 +179,39 @@ std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(recob::Track track
 } 
 
 
+std::pair<double, double> ApaCrossCosmicIdAlg::MinApaDistance(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const FlashTimeIndex& t0Tpc0, const FlashTimeIndex& t0Tpc1) const{
+
+  int tpc = fTpcGeo.DetectedInTPC(hits);
+  if(tpc == 0){
+    return MinApaDistance(track, t0Tpc0, tpc);
+  }
+  if(tpc == 1){
+    return MinApaDistance(track, t0Tpc1, tpc);
+  }
+  return std::make_pair(-99999, -99999);
+} 
+
+
 // Tag tracks with times outside the beam
-bool ApaCrossCosmicIdAlg::ApaCrossCosmicId(recob::Track track, std::vector<art::Ptr<recob::Hit>> hits, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1){
+bool ApaCrossCosmicIdAlg::ApaCrossCosmicId(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1) const{
 
   // Determine the TPC from hit collection
   int tpc = fTpcGeo.DetectedInTPC(hits);
+  if(tpc == 0) return ApaCrossCosmicId(track, tpc, MakeFlashTimeIndex(t0Tpc0), FlashTimeIndex());
+  if(tpc == 1) return ApaCrossCosmicId(track, tpc, FlashTimeIndex(), MakeFlashTimeIndex(t0Tpc1));
+  return false;
+
+}
+
+
+bool ApaCrossCosmicIdAlg::ApaCrossCosmicId(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const FlashTimeIndex& t0Tpc0, const FlashTimeIndex& t0Tpc1) const{
+
+  return ApaCrossCosmicId(track, fTpcGeo.DetectedInTPC(hits), t0Tpc0, t0Tpc1);
+
+}
+
+
+bool ApaCrossCosmicIdAlg::ApaCrossCosmicId(const recob::Track& track, int tpc, const FlashTimeIndex& t0Tpc0, const FlashTimeIndex& t0Tpc1) const{
 
   // Get the minimum distance from the APA in the corresponding TPC (with corresponding flashes)
   if(tpc == 0){
@@ -26,6 +26,7 @@
 // c++
 #include <vector>
 #include <utility>
+#include <algorithm>
 
 
 namespace sbnd{
@@ -70,6 +71,13 @@ namespace sbnd{
 
     };
 
+    // Flash times of one TPC that can be used for the crossing search (t0 >= 0) in time order,
+    // with their position in the original list. Made once per event
+    struct FlashTimeIndex {
+      std::vector<double> times;
+      std::vector<size_t> listIndex;
+    };
+
     ApaCrossCosmicIdAlg(const Config& config);
 
     ApaCrossCosmicIdAlg(const fhicl::ParameterSet& pset) :
@@ -81,20 +89,29 @@ namespace sbnd{
 
     void reconfigure(const Config& config);
 
+    // Sort a list of flash times for the crossing search
+    static FlashTimeIndex MakeFlashTimeIndex(const std::vector<double>& t0List);
+
     // Get the minimum distance from track to APA for different times
-    std::pair<double, double> MinApaDistance(recob::Track track, std::vector<double> t0List, int tpc);
+    std::pair<double, double> MinApaDistance(const recob::Track& track, const std::vector<double>& t0List, int tpc) const;
+    std::pair<double, double> MinApaDistance(const recob::Track& track, const FlashTimeIndex& t0Index, int tpc) const;
 
     // Get time by matching tracks which cross the APA
-    double T0FromApaCross(recob::Track track, std::vector<double> t0List, int tpc);
+    double T0FromApaCross(const recob::Track& track, const std::vector<double>& t0List, int tpc) const;
+    double T0FromApaCross(const recob::Track& track, const FlashTimeIndex& t0Index, int tpc) const;
 
     // Get the distance from track to APA at fixed time
-    double ApaDistance(recob::Track track, double t0, std::vector<art::Ptr<recob::Hit>> hits);
+    double ApaDistance(const recob::Track& track, double t0, const std::vector<art::Ptr<recob::Hit>>& hits) const;
 
     // Work out what TPC track is in and get the minimum distance from track to APA for different times
-    std::pair<double, double> MinApaDistance(recob::Track track, std::vector<art::Ptr<recob::Hit>> hits, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1);
+    std::pair<double, double> MinApaDistance(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1) const;
+    std::pair<double, double> MinApaDistance(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const FlashTimeIndex& t0Tpc0, const FlashTimeIndex& t0Tpc1) const;
 
     // Tag tracks with times outside the beam
-    bool ApaCrossCosmicId(recob::Track track, std::vector<art::Ptr<recob::Hit>> hits, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1);
+    bool ApaCrossCosmicId(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1) const;
+    bool ApaCrossCosmicId(const recob::Track& track, const std::vector<art::Ptr<recob::Hit>>& hits, const FlashTimeIndex& t0Tpc0, const FlashTimeIndex& t0Tpc1) const;
+    // Same with the TPC the track was detected in already known
+    bool ApaCrossCosmicId(const recob::Track& track, int tpc, const FlashTimeIndex& t0Tpc0, const FlashTimeIndex& t0Tpc1) const;
 
   private:
 
@@ -100,21 +100,72 @@ void CosmicIdAlg::ResetCuts(){
 // Run cuts to decide if track looks like a cosmic
 bool CosmicIdAlg::CosmicId(recob::Track track, const art::Event& event, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1){
 
-  // Get associations between tracks and hit collections
-  auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTpcTrackModuleLabel);
-  art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTpcTrackModuleLabel);
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(track.ID());
-  // Get associations between track and calorimetry collections
-  art::FindManyP<anab::Calorimetry> findManyCalo(tpcTrackHandle, event, fCaloModuleLabel);
+  CosmicIdEventCache cache(event, EventCacheLabels());
+  return CosmicId(track, cache, t0Tpc0, t0Tpc1);
+
+}
+
+// Run cuts to decide if PFParticle looks like a cosmic
+bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> > pfParticleMap, const art::Event& event, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1){
+
+  CosmicIdEventCache cache(event, EventCacheLabels());
+  return CosmicId(pfparticle, pfParticleMap, cache, t0Tpc0, t0Tpc1);
+
+}
+
+// Product labels this algorithm reads, for building a shared event cache
+CosmicIdEventCache::Labels CosmicIdAlg::EventCacheLabels() const{
+
+  CosmicIdEventCache::Labels labels;
+  labels.TpcTrack = fTpcTrackModuleLabel;
+  labels.Calo     = fCaloModuleLabel;
+  labels.Pandora  = fPandoraLabel;
+  labels.CrtHit   = fCrtHitModuleLabel;
+  labels.CrtTrack = fCrtTrackModuleLabel;
+  return labels;
+
+}
+
+// Run cuts to decide if track looks like a cosmic using the event cache
+bool CosmicIdAlg::CosmicId(const recob::Track& track, CosmicIdEventCache& cache, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1){
+
+  return CosmicId(track, cache, MakeFlashTimes(t0Tpc0, t0Tpc1));
+
+}
+
+// Run cuts to decide if PFParticle looks like a cosmic using the event cache
+bool CosmicIdAlg::CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, CosmicIdEventCache& cache, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1){
+
+  return CosmicId(pfparticle, pfParticleMap, cache, MakeFlashTimes(t0Tpc0, t0Tpc1));
+
+}
+
+// Sort the flash times of an event for the cuts
+CosmicIdAlg::FlashTimes CosmicIdAlg::MakeFlashTimes(const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1) const{
+
+  FlashTimes flashes;
+  flashes.tpc0BeamFlash = CosmicIdUtils::BeamFlash(t0Tpc0, fBeamTimeMin, fBeamTimeMax);
+  flashes.tpc1BeamFlash = CosmicIdUtils::BeamFlash(t0Tpc1, fBeamTimeMin, fBeamTimeMax);
+  flashes.apaTpc0 = ApaCrossCosmicIdAlg::MakeFlashTimeIndex(t0Tpc0);
+  flashes.apaTpc1 = ApaCrossCosmicIdAlg::MakeFlashTimeIndex(t0Tpc1);
+  return flashes;
+
+}
+
+// Run cuts to decide if track looks like a cosmic with the flash times sorted for the event
+bool CosmicIdAlg::CosmicId(const recob::Track& track, CosmicIdEventCache& cache, const FlashTimes& flashes){
+
+  // Hits associated to the track
+  const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(track.ID());
 
   // Tag cosmics from pandora T0 associations
   if(fApplyPandoraNuScoreCut){
-    if(pnTag.PandoraNuScoreCosmicId(track, event)) return true;
+    if(pnTag.PandoraNuScoreCosmicId(track, cache)) return true;
   }    
 
   // Tag cosmics from pandora T0 associations
   if(fApplyPandoraT0Cut){
-    if(ptTag.PandoraT0CosmicId(track, event)) return true;
+    if(ptTag.PandoraT0CosmicId(track, cache)) return true;
   }    
 
   // Tag cosmics which enter and exit the TPC
@@ -124,64 +175,40 @@ bool CosmicIdAlg::CosmicId(recob::Track track, const art::Event& event, std::vec
 
   // Tag cosmics which enter the TPC and stop
   if(fApplyStoppingCut){
-    std::vector<art::Ptr<anab::Calorimetry>> calos = findManyCalo.at(track.ID());
-    if(spTag.StoppingParticleCosmicId(track, calos)) return true;
+    if(spTag.StoppingParticleCosmicId(track, cache.Calos(track.ID()))) return true;
   }
 
   // Tag cosmics in other TPC to beam activity
   if(fApplyGeometryCut){
-    bool tpc0Flash = CosmicIdUtils::BeamFlash(t0Tpc0, fBeamTimeMin, fBeamTimeMax);
-    bool tpc1Flash = CosmicIdUtils::BeamFlash(t0Tpc1, fBeamTimeMin, fBeamTimeMax);
-    if(geoTag.GeometryCosmicId(track, hits, tpc0Flash, tpc1Flash)) return true;
+    if(geoTag.GeometryCosmicId(track, hits, flashes.tpc0BeamFlash, flashes.tpc1BeamFlash)) return true;
   }
 
   // Tag cosmics which cross the CPA
   if(fApplyCpaCrossCut){
-    std::vector<recob::Track> tracks;
-    for(auto const& tpcTrack : (*tpcTrackHandle)){
-      tracks.push_back(tpcTrack);
-    }
-
-    if(ccTag.CpaCrossCosmicId(track, tracks, findManyHits)) return true;
+    if(ccTag.CpaCrossCosmicId(track, cache.Tracks(), cache.FindManyHits())) return true;
   }
 
   // Tag cosmics which cross the APA
   if(fApplyApaCrossCut){
-    if(acTag.ApaCrossCosmicId(track, hits, t0Tpc0, t0Tpc1)) return true;
+    if(acTag.ApaCrossCosmicId(track, hits, flashes.apaTpc0, flashes.apaTpc1)) return true;
   }
 
   // Tag cosmics which match CRT tracks
   if(fApplyCrtTrackCut){
-    auto crtTrackHandle = event.getValidHandle<std::vector<crt::CRTTrack>>(fCrtTrackModuleLabel);
-    std::vector<crt::CRTTrack> crtTracks = (*crtTrackHandle);
-
-    if(ctTag.CrtTrackCosmicId(track, crtTracks, event)) return true;
+    if(ctTag.CrtTrackCosmicId(track, hits, cache.CrtTracks())) return true;
   }
 
   // Tag cosmics which match CRT hits
   if(fApplyCrtHitCut){
-    auto crtHitHandle = event.getValidHandle<std::vector<crt::CRTHit>>(fCrtHitModuleLabel);
-    std::vector<crt::CRTHit> crtHits = (*crtHitHandle);
-
-    if(chTag.CrtHitCosmicId(track, crtHits, event)) return true;
+    if(chTag.CrtHitCosmicId(track, hits, cache.CrtHits())) return true;
   }
 
   return false;
 
 }
 
-// Run cuts to decide if PFParticle looks like a cosmic
-bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> > pfParticleMap, const art::Event& event, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1){
-
-  // Get associations between pfparticles and tracks
-  art::Handle< std::vector<recob::PFParticle> > pfParticleHandle;
-  event.getByLabel(fPandoraLabel, pfParticleHandle);
-  art::FindManyP< recob::Track > pfPartToTrackAssoc(pfParticleHandle, event, fTpcTrackModuleLabel);
-
-  // Get associations between tracks and hits/calorimetry collections
-  auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTpcTrackModuleLabel);
-  art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTpcTrackModuleLabel);
-  art::FindManyP<anab::Calorimetry> findManyCalo(tpcTrackHandle, event, fCaloModuleLabel);
+// Run cuts to decide if PFParticle looks like a cosmic with the flash times sorted for the event
+bool CosmicIdAlg::CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, CosmicIdEventCache& cache, const FlashTimes& flashes){
 
   // Loop over all the daughters of the PFParticles and get associated tracks
   std::vector<recob::Track> nuTracks;
@@ -189,7 +216,7 @@ bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::
   
     // Get tracks associated with daughter
     art::Ptr<recob::PFParticle> pParticle = pfParticleMap.at(daughterId);
-    const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pParticle.key()));
+    const std::vector< art::Ptr<recob::Track> >& associatedTracks = cache.PfpTracks(pParticle.key());
     if(associatedTracks.size() != 1) continue;
 
     recob::Track track = *associatedTracks.front();
@@ -200,12 +227,12 @@ bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::
   
   // Tag cosmics from pandora MVA score
   if(fApplyPandoraNuScoreCut){
-    if(pnTag.PandoraNuScoreCosmicId(pfparticle, pfParticleMap, event)) return true;
+    if(pnTag.PandoraNuScoreCosmicId(pfparticle, cache)) return true;
   }    
 
   // Tag cosmics from pandora T0 associations
   if(fApplyPandoraT0Cut){
-    if(ptTag.PandoraT0CosmicId(pfparticle, pfParticleMap, event)) return true;
+    if(ptTag.PandoraT0CosmicId(pfparticle, pfParticleMap, cache)) return true;
   }
 
   // Not a cosmic if there are only showers assiciated with PFParticle
@@ -217,7 +244,7 @@ bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::
 
   // Select longest track as the cosmic candidate
   recob::Track track = nuTracks[0];
-  std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(track.ID());
+  const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(track.ID());
 
   // Tag cosmics which enter and exit the TPC
   if(fApplyFiducialCut){
@@ -226,27 +253,17 @@ bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::
 
   // Tag cosmics in other TPC to beam activity
   if(fApplyGeometryCut){
-    bool tpc0Flash = CosmicIdUtils::BeamFlash(t0Tpc0, fBeamTimeMin, fBeamTimeMax);
-    bool tpc1Flash = CosmicIdUtils::BeamFlash(t0Tpc1, fBeamTimeMin, fBeamTimeMax);
-    if(geoTag.GeometryCosmicId(track, hits, tpc0Flash, tpc1Flash)) return true;
+    if(geoTag.GeometryCosmicId(track, hits, flashes.tpc0BeamFlash, flashes.tpc1BeamFlash)) return true;
   }
 
   // Tag cosmics which match CRT tracks
   if(fApplyCrtTrackCut){
-    auto crtTrackHandle = event.getValidHandle<std::vector<crt::CRTTrack>>(fCrtTrackModuleLabel);
-    std::vector<crt::CRTTrack> crtTracks = (*crtTrackHandle);
-
-    if(ctTag.CrtTrackCosmicId(track, crtTracks, event)) return true;
+    if(ctTag.CrtTrackCosmicId(track, hits, cache.CrtTracks())) return true;
   }
 
   // Tag cosmics which cross the CPA
   if(fApplyCpaCrossCut){
-    std::vector<recob::Track> tracks;
-    for(auto const& tpcTrack : (*tpcTrackHandle)){
-      tracks.push_back(tpcTrack);
-    }
-
-    if(ccTag.CpaCrossCosmicId(track, tracks, findManyHits)) return true;
+    if(ccTag.CpaCrossCosmicId(track, cache.Tracks(), cache.FindManyHits())) return true;
   }
 
   // Find second longest particle if trying to merge tracks
@@ -288,29 +305,28 @@ bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::
       // Check if stopping applies to merged track
       if(fApplyStoppingCut){
         // Apply stopping cut to the longest track
-        std::vector<art::Ptr<anab::Calorimetry>> calos = findManyCalo.at(track.ID());
+        const std::vector<art::Ptr<anab::Calorimetry>>& calos = cache.Calos(track.ID());
         if(spTag.StoppingParticleCosmicId(track, calos)) return true;
         // Apply stopping cut assuming the tracks are split
-        std::vector<art::Ptr<anab::Calorimetry>> calos2 = findManyCalo.at(track2.ID());
+        const std::vector<art::Ptr<anab::Calorimetry>>& calos2 = cache.Calos(track2.ID());
         if(spTag.StoppingParticleCosmicId(track, track2, calos, calos2)) return true;
       }
 
       // Check if either track crosses APA
       if(fApplyApaCrossCut){
         // Apply apa crossing cut to the longest track
-        if(acTag.ApaCrossCosmicId(track, hits, t0Tpc0, t0Tpc1)) return true;
+        if(acTag.ApaCrossCosmicId(track, hits, flashes.apaTpc0, flashes.apaTpc1)) return true;
         // Also apply to secondary track FIXME need to check primary track doesn't go out of bounds
-        std::vector<art::Ptr<recob::Hit>> hits2 = findManyHits.at(track2.ID());
-        if(acTag.ApaCrossCosmicId(track2, hits2, t0Tpc0, t0Tpc1)) return true;
+        const std::vector<art::Ptr<recob::Hit>>& hits2 = cache.Hits(track2.ID());
+        if(acTag.ApaCrossCosmicId(track2, hits2, flashes.apaTpc0, flashes.apaTpc1)) return true;
       }
 
       // Check if either track matches CRT hit
       if(fApplyCrtHitCut){
         // Apply crt hit match cut to both tracks
-        auto crtHitHandle = event.getValidHandle<std::vector<crt::CRTHit>>(fCrtHitModuleLabel);
-        std::vector<crt::CRTHit> crtHits = (*crtHitHandle);
-        if(chTag.CrtHitCosmicId(track, crtHits, event)) return true;
-        if(chTag.CrtHitCosmicId(track2, crtHits, event)) return true;
+        const std::vector<crt::CRTHit>& crtHits = cache.CrtHits();
+        if(chTag.CrtHitCosmicId(track, hits, crtHits)) return true;
+        if(chTag.CrtHitCosmicId(track2, cache.Hits(track2.ID()), crtHits)) return true;
       }
     }
     // Don't apply other cuts if angle between tracks is consistent with neutrino interaction
@@ -321,21 +337,17 @@ bool CosmicIdAlg::CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::
 
     // Tag cosmics which enter the TPC and stop
     if(fApplyStoppingCut){
-      std::vector<art::Ptr<anab::Calorimetry>> calos = findManyCalo.at(track.ID());
-      if(spTag.StoppingParticleCosmicId(track, calos)) return true;
+      if(spTag.StoppingParticleCosmicId(track, cache.Calos(track.ID()))) return true;
     }
 
     // Tag cosmics which cross the APA
     if(fApplyApaCrossCut){
-      if(acTag.ApaCrossCosmicId(track, hits, t0Tpc0, t0Tpc1)) return true;
+      if(acTag.ApaCrossCosmicId(track, hits, flashes.apaTpc0, flashes.apaTpc1)) return true;
     }
 
     // Tag cosmics which match CRT hits
     if(fApplyCrtHitCut){
-      auto crtHitHandle = event.getValidHandle<std::vector<crt::CRTHit>>(fCrtHitModuleLabel);
-      std::vector<crt::CRTHit> crtHits = (*crtHitHandle);
-
-      if(chTag.CrtHitCosmicId(track, crtHits, event)) return true;
+      if(chTag.CrtHitCosmicId(track, hits, cache.CrtHits())) return true;
     }
   }
 
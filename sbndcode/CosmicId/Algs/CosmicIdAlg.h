@@ -19,6 +19,7 @@
 #include "sbndcode/CosmicId/Algs/PandoraT0CosmicIdAlg.h"
 #include "sbndcode/CosmicId/Algs/PandoraNuScoreCosmicIdAlg.h"
 #include "sbndcode/CosmicId/Utils/CosmicIdUtils.h"
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
 
 // framework
 #include "art/Framework/Principal/Event.h"
@@ -194,6 +195,14 @@ namespace sbnd{
 
     };
 
+    // Flash information used by the cuts, worked out once per event
+    struct FlashTimes {
+      bool tpc0BeamFlash;
+      bool tpc1BeamFlash;
+      ApaCrossCosmicIdAlg::FlashTimeIndex apaTpc0;
+      ApaCrossCosmicIdAlg::FlashTimeIndex apaTpc1;
+    };
+
     CosmicIdAlg(const Config& config);
 
     CosmicIdAlg(const fhicl::ParameterSet& pset) :
@@ -217,11 +226,25 @@ namespace sbnd{
     // Run cuts to decide if PFParticle looks like a cosmic
     bool CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> > pfParticleMap, const art::Event& event, std::vector<double> t0Tpc0, std::vector<double> t0Tpc1);
 
+    // Product labels this algorithm reads, for building a shared event cache
+    CosmicIdEventCache::Labels EventCacheLabels() const;
+
+    // Same as above but reusing associations already resolved for the event
+    bool CosmicId(const recob::Track& track, CosmicIdEventCache& cache, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1);
+    bool CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, CosmicIdEventCache& cache, const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1);
+
+    // Sort the flash times of an event for the cuts
+    FlashTimes MakeFlashTimes(const std::vector<double>& t0Tpc0, const std::vector<double>& t0Tpc1) const;
+
+    // Same as above with the flash times already sorted for the event
+    bool CosmicId(const recob::Track& track, CosmicIdEventCache& cache, const FlashTimes& flashes);
+    bool CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, CosmicIdEventCache& cache, const FlashTimes& flashes);
+
     // Getters for the underlying algorithms
     StoppingParticleCosmicIdAlg StoppingAlg() const {return spTag;}
     CrtHitCosmicIdAlg CrtHitAlg() const {return chTag;}
     CrtTrackCosmicIdAlg CrtTrackAlg() const {return ctTag;}
-    ApaCrossCosmicIdAlg ApaAlg() const {return acTag;}
+    const ApaCrossCosmicIdAlg& ApaAlg() const {return acTag;}
     PandoraNuScoreCosmicIdAlg PandoraNuScoreAlg() const {return pnTag;}
 
   private:
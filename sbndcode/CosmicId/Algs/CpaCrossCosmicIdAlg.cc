@@ -113,7 +113,7 @@ std::pair<double, bool> CpaCrossCosmicIdAlg::T0FromCpaStitching(recob::Track t1,
 }
 
 // Tag tracks as cosmics from CPA stitching t0
-bool CpaCrossCosmicIdAlg::CpaCrossCosmicId(recob::Track track, std::vector<recob::Track> tracks, art::FindManyP<recob::Hit> hitAssoc){
+bool CpaCrossCosmicIdAlg::CpaCrossCosmicId(recob::Track track, const std::vector<recob::Track>& tracks, const art::FindManyP<recob::Hit>& hitAssoc){
 
   // Sort tracks by tpc
   std::vector<recob::Track> tpcTracksTPC0;
@@ -110,7 +110,7 @@ namespace sbnd{
     std::pair<double, bool> T0FromCpaStitching(recob::Track t1, std::vector<recob::Track> tracks);
 
     // Tag tracks as cosmics from CPA stitching t0
-    bool CpaCrossCosmicId(recob::Track track, std::vector<recob::Track> tracks, art::FindManyP<recob::Hit> hitAssoc);
+    bool CpaCrossCosmicId(recob::Track track, const std::vector<recob::Track>& tracks, const art::FindManyP<recob::Hit>& hitAssoc);
 
   private:
 
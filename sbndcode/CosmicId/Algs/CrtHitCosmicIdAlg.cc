@@ -41,5 +41,17 @@ bool CrtHitCosmicIdAlg::CrtHitCosmicId(recob::Track track, std::vector<crt::CRTH
   return false;
 
 } //CrtHitCosmicId()
+
+bool CrtHitCosmicIdAlg::CrtHitCosmicId(recob::Track track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTHit>& crtHits){
+
+  // Get the closest matched time from CRT hits
+  double crtHitTime = t0Alg.T0FromCRTHits(track, hits, crtHits);
+
+  // If time is valid and outside the beam time then tag as a cosmic
+  if(crtHitTime != -99999 && (crtHitTime < fBeamTimeMin || crtHitTime > fBeamTimeMax)) return true;
+
+  return false;
+
+} //CrtHitCosmicId()
  
 }
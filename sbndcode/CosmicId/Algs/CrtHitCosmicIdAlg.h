@@ -21,6 +21,7 @@
 
 // LArSoft
 #include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Hit.h"
 
 // c++
 #include <vector>
@@ -76,6 +77,8 @@ namespace sbnd{
 
     // Returns true if matched to CRTHit outside beam time
     bool CrtHitCosmicId(recob::Track track, std::vector<crt::CRTHit> crtHits, const art::Event& event);
+    // Same with the track hits already resolved
+    bool CrtHitCosmicId(recob::Track track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTHit>& crtHits);
 
     // Getter for matching algorithm
     CRTT0MatchAlg T0Alg() const {return t0Alg;}
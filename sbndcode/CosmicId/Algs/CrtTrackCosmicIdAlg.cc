@@ -48,5 +48,25 @@ bool CrtTrackCosmicIdAlg::CrtTrackCosmicId(recob::Track track, std::vector<crt::
   return false;
 
 }
+
+// Tags track as cosmic if it matches a CRTTrack, track hits already resolved
+bool CrtTrackCosmicIdAlg::CrtTrackCosmicId(recob::Track track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks){
+
+  // Get the closest matching CRT track ID
+  int crtID = trackMatchAlg.GetMatchedCRTTrackId(track, hits, crtTracks);
+
+  // If matching failed
+  if(crtID == -99999) return false;
+
+  // If track matched to a through going CRT track then it is a cosmic
+  if(crtTracks.at(crtID).complete) return true;
+
+  // If it matches a track through just the top planes make sure it is outside of the beam time
+  double crtTime = ((double)(int)crtTracks.at(crtID).ts1_ns) * 1e-3; // [us]
+  if(crtTime < fBeamTimeMin || crtTime > fBeamTimeMax) return true;
+
+  return false;
+
+}
  
 }
@@ -21,6 +21,7 @@
 
 // LArSoft
 #include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Hit.h"
 
 // c++
 #include <vector>
@@ -76,6 +77,8 @@ namespace sbnd{
 
     // Tags track as cosmic if it matches a CRTTrack
     bool CrtTrackCosmicId(recob::Track track, std::vector<crt::CRTTrack> crtTracks, const art::Event& event);
+    // Same with the track hits already resolved
+    bool CrtTrackCosmicId(recob::Track track, const std::vector<art::Ptr<recob::Hit>>& hits, const std::vector<crt::CRTTrack>& crtTracks);
 
     // Getter for matching algorithm
     CRTTrackMatchAlg TrackAlg() const {return trackMatchAlg;}
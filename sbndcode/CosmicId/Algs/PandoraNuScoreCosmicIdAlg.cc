@@ -29,38 +29,16 @@ namespace sbnd{
   }
 
   // Finds any t0s associated with track by pandora, tags if outside beam
-  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(recob::Track track, const art::Event& event){
+  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(const recob::Track& track, const art::Event& event){
 
-    // Get the pfps and associations
-    art::Handle< std::vector<recob::PFParticle> > pfParticleHandle;
-    event.getByLabel(fPandoraLabel, pfParticleHandle);
-    art::FindManyP<recob::Track> pfPartToTrackAssoc(pfParticleHandle, event, fTpcTrackModuleLabel);
-    art::FindManyP<larpandoraobj::PFParticleMetadata> PFPMetaDataAssoc(pfParticleHandle, event, fPandoraLabel);
-
-    // Loop over all the pfps
-    for(auto const pfp : (*pfParticleHandle)){
-      // Get the associated track if there is one
-      const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pfp.Self()));
-      if(associatedTracks.size() != 1) continue;
-      recob::Track trk = *associatedTracks.front();
-      if(trk.ID() != track.ID()) continue;
-
-      recob::PFParticle PFPNeutrino = GetPFPNeutrino(pfp, (*pfParticleHandle));
-
-      float pfpNuScore = GetPandoraNuScore(PFPNeutrino, PFPMetaDataAssoc);
-      if (pfpNuScore < fNuScoreCut){
-        return true;
-      } else {
-        return false;
-      }
-    }
-    return false;
+    PandoraPfpIndex pfpIndex(event, fPandoraLabel, fTpcTrackModuleLabel);
+    return PandoraNuScoreCosmicId(track, pfpIndex);
 
   }
 
   // Finds any t0s associated with pfparticle by pandora, tags if outside beam
-  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(recob::PFParticle pfparticle,
-      std::map< size_t, art::Ptr<recob::PFParticle> > pfParticleMap, const art::Event& event){
+  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(const recob::PFParticle& pfparticle,
+      const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, const art::Event& event){
 
     // Get pfp associations to t0s
     art::Handle< std::vector<recob::PFParticle> > pfParticleHandle;
@@ -78,8 +56,38 @@ namespace sbnd{
     return false;
   }
 
+  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(const recob::Track& track, PandoraPfpIndex& pfpIndex){
+
+    // Only the first PFParticle made from the track is used
+    const std::vector<size_t>& trackPfps = pfpIndex.TrackPfps(track.ID());
+    if(trackPfps.empty()) return false;
+
+    float pfpNuScore = pfpIndex.NuScore(pfpIndex.Neutrino(trackPfps.front()));
+    return pfpNuScore < fNuScoreCut;
+
+  }
+
+  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(const recob::PFParticle& pfparticle, PandoraPfpIndex& pfpIndex){
+
+    float pfpNuScore = pfpIndex.NuScore(pfpIndex.Neutrino(pfparticle.Self()));
+    return pfpNuScore < fNuScoreCut;
+
+  }
+
+  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(const recob::Track& track, CosmicIdEventCache& cache){
+
+    return PandoraNuScoreCosmicId(track, cache.PfpIndex(fPandoraLabel, fTpcTrackModuleLabel));
+
+  }
+
+  bool PandoraNuScoreCosmicIdAlg::PandoraNuScoreCosmicId(const recob::PFParticle& pfparticle, CosmicIdEventCache& cache){
+
+    return PandoraNuScoreCosmicId(pfparticle, cache.PfpIndex(fPandoraLabel, fTpcTrackModuleLabel));
+
+  }
+
 
-  recob::PFParticle PandoraNuScoreCosmicIdAlg::GetPFPNeutrino(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap){
+  recob::PFParticle PandoraNuScoreCosmicIdAlg::GetPFPNeutrino(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap){
 
     if ((pfparticle.PdgCode()==12) ||(pfparticle.PdgCode()==14)){
       return pfparticle;
@@ -89,7 +97,7 @@ namespace sbnd{
     }
   }
 
-  recob::PFParticle PandoraNuScoreCosmicIdAlg::GetPFPNeutrino(recob::PFParticle pfparticle,
+  recob::PFParticle PandoraNuScoreCosmicIdAlg::GetPFPNeutrino(const recob::PFParticle& pfparticle,
       const std::vector<recob::PFParticle>& pfpVec){
 
     if ((pfparticle.PdgCode()==12) ||(pfparticle.PdgCode()==14)){
@@ -107,10 +115,10 @@ namespace sbnd{
     }
   }
 
-  float PandoraNuScoreCosmicIdAlg::GetPandoraNuScore(recob::PFParticle pfparticle,
-      art::FindManyP<larpandoraobj::PFParticleMetadata> PFPMetaDataAssoc){
+  float PandoraNuScoreCosmicIdAlg::GetPandoraNuScore(const recob::PFParticle& pfparticle,
+      const art::FindManyP<larpandoraobj::PFParticleMetadata>& PFPMetaDataAssoc){
 
-    const std::vector<art::Ptr<larpandoraobj::PFParticleMetadata> > pfpMetaVec =
+    const std::vector<art::Ptr<larpandoraobj::PFParticleMetadata> >& pfpMetaVec =
       PFPMetaDataAssoc.at(pfparticle.Self());
 
     if (pfpMetaVec.size() !=1){
@@ -118,9 +126,9 @@ namespace sbnd{
       return 99999;
     }
 
-    art::Ptr<larpandoraobj::PFParticleMetadata> pfpMeta = pfpMetaVec.front();
+    const art::Ptr<larpandoraobj::PFParticleMetadata>& pfpMeta = pfpMetaVec.front();
 
-    larpandoraobj::PFParticleMetadata::PropertiesMap propertiesMap = pfpMeta->GetPropertiesMap();
+    const larpandoraobj::PFParticleMetadata::PropertiesMap& propertiesMap = pfpMeta->GetPropertiesMap();
     auto propertiesMapIter = propertiesMap.find("NuScore");
     if (propertiesMapIter == propertiesMap.end()){
       std::cout<<"Cannot get PFP Nu Score in Metadata"<<std::endl;
@@ -25,6 +25,11 @@
 #include "lardataobj/RecoBase/PFParticle.h"
 #include "lardataobj/AnalysisBase/T0.h"
 #include "lardataobj/RecoBase/PFParticleMetadata.h"
+
+// sbndcode
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
+#include "sbndcode/CosmicId/Utils/PandoraPfpIndex.h"
+
 // c++
 #include <vector>
 #include <iostream>
@@ -67,17 +72,23 @@ namespace sbnd{
       void reconfigure(const Config& config);
 
       // Finds any t0s associated with track by pandora, tags if outside beam
-      bool PandoraNuScoreCosmicId(recob::Track track, const art::Event& event);
+      bool PandoraNuScoreCosmicId(const recob::Track& track, const art::Event& event);
 
       // Finds any t0s associated with pfparticle by pandora, tags if outside beam
-      bool PandoraNuScoreCosmicId(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> > pfParticleMap, const art::Event& event);
+      bool PandoraNuScoreCosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, const art::Event& event);
+
+      // Same as above looking the PFParticle hierarchy up in an index made once per event
+      bool PandoraNuScoreCosmicId(const recob::Track& track, PandoraPfpIndex& pfpIndex);
+      bool PandoraNuScoreCosmicId(const recob::PFParticle& pfparticle, PandoraPfpIndex& pfpIndex);
+      bool PandoraNuScoreCosmicId(const recob::Track& track, CosmicIdEventCache& cache);
+      bool PandoraNuScoreCosmicId(const recob::PFParticle& pfparticle, CosmicIdEventCache& cache);
 
-      recob::PFParticle GetPFPNeutrino(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap);
+      recob::PFParticle GetPFPNeutrino(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap);
 
-      recob::PFParticle GetPFPNeutrino(recob::PFParticle pfp, const std::vector<recob::PFParticle>& pfpVec);
+      recob::PFParticle GetPFPNeutrino(const recob::PFParticle& pfp, const std::vector<recob::PFParticle>& pfpVec);
 
-      float GetPandoraNuScore(recob::PFParticle pfparticle,
-          art::FindManyP<larpandoraobj::PFParticleMetadata> PFPMetaDataAssoc);
+      float GetPandoraNuScore(const recob::PFParticle& pfparticle,
+          const art::FindManyP<larpandoraobj::PFParticleMetadata>& PFPMetaDataAssoc);
 
     private:
 
@@ -30,23 +30,27 @@ void PandoraT0CosmicIdAlg::reconfigure(const Config& config){
 }
 
 // Finds any t0s associated with track by pandora, tags if outside beam
-bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(recob::Track track, const art::Event& event){
-
-  // Get the pfps and associations
-  art::Handle< std::vector<recob::PFParticle> > pfParticleHandle;
-  event.getByLabel(fPandoraLabel, pfParticleHandle);
-  art::FindManyP<recob::Track> pfPartToTrackAssoc(pfParticleHandle, event, fTpcTrackModuleLabel);
-  art::FindManyP<anab::T0> findManyT0(pfParticleHandle, event, fPandoraLabel);
-
-  // Loop over all the pfps
-  for(auto const pfp : (*pfParticleHandle)){
-    // Get the associated track if there is one
-    const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pfp.Self()));
-    if(associatedTracks.size() != 1) continue;
-    recob::Track trk = *associatedTracks.front();
-    if(trk.ID() != track.ID()) continue;
+bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(const recob::Track& track, const art::Event& event){
+
+  PandoraPfpIndex pfpIndex(event, fPandoraLabel, fTpcTrackModuleLabel);
+  return PandoraT0CosmicId(track, pfpIndex);
+
+}
+
+// Finds any t0s associated with pfparticle by pandora, tags if outside beam
+bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, const art::Event& event){
+
+  PandoraPfpIndex pfpIndex(event, fPandoraLabel, fTpcTrackModuleLabel);
+  return PandoraT0CosmicId(pfparticle, pfParticleMap, pfpIndex);
+
+}
+
+bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(const recob::Track& track, PandoraPfpIndex& pfpIndex){
+
+  // Loop over the pfps made from the track
+  for(auto const& pfpSelf : pfpIndex.TrackPfps(track.ID())){
     // Get the associated t0
-    const std::vector< art::Ptr<anab::T0> > associatedT0s(findManyT0.at(pfp.Self()));
+    const std::vector< art::Ptr<anab::T0> >& associatedT0s = pfpIndex.T0s(pfpSelf);
 
     // If any t0 outside of beam limits then remove
     for(size_t i = 0; i < associatedT0s.size(); i++){
@@ -59,19 +63,13 @@ bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(recob::Track track, const art::Even
 
 }
 
-// Finds any t0s associated with pfparticle by pandora, tags if outside beam
-bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> > pfParticleMap, const art::Event& event){
-
-  // Get pfp associations to t0s
-  art::Handle< std::vector<recob::PFParticle> > pfParticleHandle;
-  event.getByLabel(fPandoraLabel, pfParticleHandle);
-  art::FindManyP<anab::T0> findManyT0(pfParticleHandle, event, fPandoraLabel);
+bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, PandoraPfpIndex& pfpIndex){
 
   // Loop over daughters
   for (const size_t daughterId : pfparticle.Daughters()){
     // Get associated t0s
-    art::Ptr<recob::PFParticle> pParticle = pfParticleMap.at(daughterId);
-    const std::vector< art::Ptr<anab::T0> > associatedT0s(findManyT0.at(pParticle.key()));
+    const art::Ptr<recob::PFParticle>& pParticle = pfParticleMap.at(daughterId);
+    const std::vector< art::Ptr<anab::T0> >& associatedT0s = pfpIndex.T0s(pParticle.key());
 
     // If any t0 outside of beam limits then remove
     for(size_t i = 0; i < associatedT0s.size(); i++){
@@ -84,5 +82,17 @@ bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(recob::PFParticle pfparticle, std::
 
 }
 
+bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(const recob::Track& track, CosmicIdEventCache& cache){
+
+  return PandoraT0CosmicId(track, cache.PfpIndex(fPandoraLabel, fTpcTrackModuleLabel));
+
+}
+
+bool PandoraT0CosmicIdAlg::PandoraT0CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, CosmicIdEventCache& cache){
+
+  return PandoraT0CosmicId(pfparticle, pfParticleMap, cache.PfpIndex(fPandoraLabel, fTpcTrackModuleLabel));
+
+}
+
 
 }
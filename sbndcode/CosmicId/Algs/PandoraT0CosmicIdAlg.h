@@ -25,6 +25,10 @@
 #include "lardataobj/RecoBase/PFParticle.h"
 #include "lardataobj/AnalysisBase/T0.h"
 
+// sbndcode
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
+#include "sbndcode/CosmicId/Utils/PandoraPfpIndex.h"
+
 // c++
 #include <vector>
 
@@ -83,10 +87,16 @@ namespace sbnd{
     void reconfigure(const Config& config);
 
     // Finds any t0s associated with track by pandora, tags if outside beam
-    bool PandoraT0CosmicId(recob::Track track, const art::Event& event);
+    bool PandoraT0CosmicId(const recob::Track& track, const art::Event& event);
 
     // Finds any t0s associated with pfparticle by pandora, tags if outside beam
-    bool PandoraT0CosmicId(recob::PFParticle pfparticle, std::map< size_t, art::Ptr<recob::PFParticle> > pfParticleMap, const art::Event& event);
+    bool PandoraT0CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, const art::Event& event);
+
+    // Same as above using an index of the PFParticles made once per event
+    bool PandoraT0CosmicId(const recob::Track& track, PandoraPfpIndex& pfpIndex);
+    bool PandoraT0CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, PandoraPfpIndex& pfpIndex);
+    bool PandoraT0CosmicId(const recob::Track& track, CosmicIdEventCache& cache);
+    bool PandoraT0CosmicId(const recob::PFParticle& pfparticle, const std::map< size_t, art::Ptr<recob::PFParticle> >& pfParticleMap, CosmicIdEventCache& cache);
 
   private:
 
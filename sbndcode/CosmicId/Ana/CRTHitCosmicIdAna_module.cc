@@ -12,6 +12,7 @@
 #include "sbndcode/CRT/CRTUtils/CRTT0MatchAlg.h"
 #include "sbndcode/CRT/CRTUtils/CRTBackTracker.h"
 #include "sbndcode/CosmicId/Algs/CrtHitCosmicIdAlg.h"
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
 #include "sbndcode/Geometry/GeometryWrappers/TPCGeoAlg.h"
 
 // LArSoft includes
@@ -198,33 +199,28 @@ namespace sbnd {
     //                                          GETTING PRODUCTS
     //----------------------------------------------------------------------------------------------------------
 
-    // Get g4 particles
-    art::ServiceHandle<cheat::ParticleInventoryService> pi_serv;
-    auto particleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fSimModuleLabel);
+    // Truth, tracks, associations and CRT hits, resolved once per event
+    CosmicIdEventCache::Labels cacheLabels;
+    cacheLabels.SimModule = fSimModuleLabel;
+    cacheLabels.TpcTrack  = fTPCTrackLabel;
+    cacheLabels.Pandora   = fPandoraLabel;
+    cacheLabels.CrtHit    = fCRTHitLabel;
+    CosmicIdEventCache cache(event, cacheLabels);
 
     // Get CRT hits from the event
-    art::Handle< std::vector<crt::CRTHit>> crtHitHandle;
-    std::vector<art::Ptr<crt::CRTHit> > crtHitList;
-    if (event.getByLabel(fCRTHitLabel, crtHitHandle))
-      art::fill_ptr_vector(crtHitList, crtHitHandle);
+    const std::vector<crt::CRTHit>& crtHits = cache.CrtHits();
 
     fCrtBackTrack.Initialize(event);
-    std::vector<crt::CRTHit> crtHits;
     std::map<int, int> numHitMap;
     int hit_i = 0;
-    for(auto const& hit : (crtHitList)){
-      crtHits.push_back(*hit);
+    for(auto const& hit : crtHits){
       int hitTrueID = fCrtBackTrack.TrueIdFromHitId(event, hit_i);
       hit_i++;
-      double hitTime = hit->ts1_ns * 1e-3;
+      double hitTime = hit.ts1_ns * 1e-3;
       if(hitTime > 0 && hitTime < 4) continue;
       numHitMap[hitTrueID]++;
     }
 
-    // Get reconstructed tracks from the event
-    auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
-    art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-
     // Get PFParticles from pandora
     PFParticleHandle pfParticleHandle;
     event.getByLabel(fPandoraLabel, pfParticleHandle);
@@ -234,27 +230,22 @@ namespace sbnd {
     }
     PFParticleIdMap pfParticleMap;
     this->GetPFParticleIdMap(pfParticleHandle, pfParticleMap);
-    // Get PFParticle to track associations
-    art::FindManyP< recob::Track > pfPartToTrackAssoc(pfParticleHandle, event, fTPCTrackLabel);
 
     //----------------------------------------------------------------------------------------------------------
     //                                          TRUTH MATCHING
     //----------------------------------------------------------------------------------------------------------
     
-    std::map<int, simb::MCParticle> particles;
     std::vector<int> nuParticleIds;
     std::vector<int> lepParticleIds;
     std::vector<int> dirtParticleIds;
     std::vector<int> crParticleIds;
     // Loop over the true particles
-    for (auto const& particle: (*particleHandle)){
+    for (auto const& particle: cache.Particles()){
       
-      // Make map with ID
       int partID = particle.TrackId();
-      particles[partID] = particle;
 
       // Get MCTruth
-      art::Ptr<simb::MCTruth> truth = pi_serv->TrackIdToMCTruth_P(partID);
+      art::Ptr<simb::MCTruth> truth = cache.Truth(partID);
       int pdg = std::abs(particle.PdgCode());
 
       // If origin is a neutrino
@@ -287,10 +278,10 @@ namespace sbnd {
     //----------------------------------------------------------------------------------------------------------
 
     // Loop over reconstructed tracks
-    for (auto const& tpcTrack : (*tpcTrackHandle)){
+    for (auto const& tpcTrack : cache.Tracks()){
       // Get the associated hits
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trackTrueID = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(tpcTrack.ID());
+      int trackTrueID = cache.TrueId(tpcTrack.ID());
       std::string type = "none";
       if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trackTrueID) != lepParticleIds.end()) type = "NuMuTrack";
       if(std::find(nuParticleIds.begin(), nuParticleIds.end(), trackTrueID) != nuParticleIds.end()) type = "NuTrack";
@@ -299,7 +290,7 @@ namespace sbnd {
       if(type == "none") continue;
 
       // Calculate t0 from CRT Hit matching
-      std::pair<crt::CRTHit, double> closest = t0Alg.ClosestCRTHit(tpcTrack, crtHits, event);
+      std::pair<crt::CRTHit, double> closest = t0Alg.ClosestCRTHit(tpcTrack, hits, crtHits);
 
       if(closest.second != -99999){
         int hitTrueID = fCrtBackTrack.TrueIdFromTotalEnergy(event, closest.first);
@@ -334,7 +325,7 @@ namespace sbnd {
       }
 
       hLengthTotal[type]->Fill(tpcTrack.Length());
-      if(chTag.CrtHitCosmicId(tpcTrack, crtHits, event)){
+      if(chTag.CrtHitCosmicId(tpcTrack, hits, crtHits)){
         hLengthTag[type]->Fill(tpcTrack.Length());
       }
     }
@@ -359,7 +350,7 @@ namespace sbnd {
 
         // Get tracks associated with daughter
         art::Ptr<recob::PFParticle> pDaughter = pfParticleMap.at(daughterId);
-        const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pDaughter.key()));
+        const std::vector< art::Ptr<recob::Track> >& associatedTracks = cache.PfpTracks(pDaughter.key());
         if(associatedTracks.size() != 1) continue;
 
         // Get the first associated track
@@ -367,8 +358,7 @@ namespace sbnd {
         nuTracks.push_back(tpcTrack);
 
         // Truth match muon tracks and pfps
-        std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-        int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+        int trueId = cache.TrueId(tpcTrack.ID());
         if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trueId) != lepParticleIds.end()){ 
           type = "NuMuPfp";
         }
@@ -389,8 +379,8 @@ namespace sbnd {
                 return left.Length() > right.Length();});
 
       recob::Track tpcTrack = nuTracks[0];
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trackTrueID = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(tpcTrack.ID());
+      int trackTrueID = cache.TrueId(tpcTrack.ID());
 
       if(numHitMap.find(trackTrueID) != numHitMap.end()){
         hNumTrueMatches[type]->Fill(numHitMap[trackTrueID]);
@@ -400,7 +390,7 @@ namespace sbnd {
       }
 
       // Calculate t0 from CRT Hit matching
-      std::pair<crt::CRTHit, double> closest = t0Alg.ClosestCRTHit(tpcTrack, crtHits, event);
+      std::pair<crt::CRTHit, double> closest = t0Alg.ClosestCRTHit(tpcTrack, hits, crtHits);
 
       if(closest.second != -99999){
         int hitTrueID = fCrtBackTrack.TrueIdFromTotalEnergy(event, closest.first);
@@ -429,7 +419,7 @@ namespace sbnd {
       }
 
       hLengthTotal[type]->Fill(tpcTrack.Length());
-      if(chTag.CrtHitCosmicId(tpcTrack, crtHits, event)){
+      if(chTag.CrtHitCosmicId(tpcTrack, hits, crtHits)){
         hLengthTag[type]->Fill(tpcTrack.Length());
       }
     }
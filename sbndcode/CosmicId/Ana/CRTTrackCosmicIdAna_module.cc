@@ -12,6 +12,7 @@
 #include "sbndcode/CRT/CRTUtils/CRTTrackMatchAlg.h"
 #include "sbndcode/CRT/CRTUtils/CRTBackTracker.h"
 #include "sbndcode/CosmicId/Algs/CrtTrackCosmicIdAlg.h"
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
 #include "sbndcode/Geometry/GeometryWrappers/TPCGeoAlg.h"
 
 // LArSoft includes
@@ -202,33 +203,28 @@ namespace sbnd {
     //                                          GETTING PRODUCTS
     //----------------------------------------------------------------------------------------------------------
 
-    // Get g4 particles
-    art::ServiceHandle<cheat::ParticleInventoryService> pi_serv;
-    auto particleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fSimModuleLabel);
+    // Truth, tracks, associations and CRT tracks, resolved once per event
+    CosmicIdEventCache::Labels cacheLabels;
+    cacheLabels.SimModule = fSimModuleLabel;
+    cacheLabels.TpcTrack  = fTPCTrackLabel;
+    cacheLabels.Pandora   = fPandoraLabel;
+    cacheLabels.CrtTrack  = fCRTTrackLabel;
+    CosmicIdEventCache cache(event, cacheLabels);
 
-    // Get CRT hits from the event
-    art::Handle< std::vector<crt::CRTTrack>> crtTrackHandle;
-    std::vector<art::Ptr<crt::CRTTrack> > crtTrackList;
-    if (event.getByLabel(fCRTTrackLabel, crtTrackHandle))
-      art::fill_ptr_vector(crtTrackList, crtTrackHandle);
+    // Get CRT tracks from the event
+    const std::vector<crt::CRTTrack>& crtTracks = cache.CrtTracks();
 
     fCrtBackTrack.Initialize(event);
-    std::vector<crt::CRTTrack> crtTracks;
     std::map<int, int> numCrtTrackMap;
     int track_i = 0;
-    for(auto const& track : (crtTrackList)){
-      crtTracks.push_back(*track);
+    for(auto const& track : crtTracks){
       int trackTrueID = fCrtBackTrack.TrueIdFromTrackId(event, track_i);
       track_i++;
-      double trackTime = track->ts1_ns * 1e-3;
+      double trackTime = track.ts1_ns * 1e-3;
       if(trackTime > 0 && trackTime < 4) continue;
       numCrtTrackMap[trackTrueID]++;
     }
 
-    // Get reconstructed tracks from the event
-    auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
-    art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-
     // Get PFParticles from pandora
     PFParticleHandle pfParticleHandle;
     event.getByLabel(fPandoraLabel, pfParticleHandle);
@@ -238,27 +234,22 @@ namespace sbnd {
     }
     PFParticleIdMap pfParticleMap;
     this->GetPFParticleIdMap(pfParticleHandle, pfParticleMap);
-    // Get PFParticle to track associations
-    art::FindManyP< recob::Track > pfPartToTrackAssoc(pfParticleHandle, event, fTPCTrackLabel);
 
     //----------------------------------------------------------------------------------------------------------
     //                                          TRUTH MATCHING
     //----------------------------------------------------------------------------------------------------------
     
-    std::map<int, simb::MCParticle> particles;
     std::vector<int> nuParticleIds;
     std::vector<int> lepParticleIds;
     std::vector<int> dirtParticleIds;
     std::vector<int> crParticleIds;
     // Loop over the true particles
-    for (auto const& particle: (*particleHandle)){
+    for (auto const& particle: cache.Particles()){
       
-      // Make map with ID
       int partID = particle.TrackId();
-      particles[partID] = particle;
 
       // Get MCTruth
-      art::Ptr<simb::MCTruth> truth = pi_serv->TrackIdToMCTruth_P(partID);
+      art::Ptr<simb::MCTruth> truth = cache.Truth(partID);
       int pdg = std::abs(particle.PdgCode());
 
       // If origin is a neutrino
@@ -291,10 +282,10 @@ namespace sbnd {
     //----------------------------------------------------------------------------------------------------------
 
     // Loop over reconstructed tracks
-    for (auto const& tpcTrack : (*tpcTrackHandle)){
+    for (auto const& tpcTrack : cache.Tracks()){
       // Get the associated hits
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trackTrueID = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(tpcTrack.ID());
+      int trackTrueID = cache.TrueId(tpcTrack.ID());
       std::string type = "none";
       if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trackTrueID) != lepParticleIds.end()) type = "NuMuTrack";
       if(std::find(nuParticleIds.begin(), nuParticleIds.end(), trackTrueID) != nuParticleIds.end()) type = "NuTrack";
@@ -310,8 +301,9 @@ namespace sbnd {
       }
 
       // Calculate t0 from CRT track matching
-      std::pair<crt::CRTTrack, double> closestAngle = trackAlg.ClosestCRTTrackByAngle(tpcTrack, crtTracks, event);
-      std::pair<crt::CRTTrack, double> closestDCA = trackAlg.ClosestCRTTrackByDCA(tpcTrack, crtTracks, event);
+      TPCGeoUtil::TrackSummary trackSummary = trackAlg.MakeTrackSummary(tpcTrack, hits);
+      std::pair<crt::CRTTrack, double> closestAngle = trackAlg.ClosestCRTTrackByAngle(trackSummary, crtTracks);
+      std::pair<crt::CRTTrack, double> closestDCA = trackAlg.ClosestCRTTrackByDCA(trackSummary, crtTracks);
 
       if(closestAngle.second != -99999){
         int crtTrackTrueID = fCrtBackTrack.TrueIdFromTotalEnergy(event, closestAngle.first);
@@ -350,7 +342,7 @@ namespace sbnd {
       }
 
       hLengthTotal[type]->Fill(tpcTrack.Length());
-      if(ctTag.CrtTrackCosmicId(tpcTrack, crtTracks, event)){
+      if(ctTag.CrtTrackCosmicId(tpcTrack, hits, crtTracks)){
         hLengthTag[type]->Fill(tpcTrack.Length());
       }
     }
@@ -376,7 +368,7 @@ namespace sbnd {
 
         // Get tracks associated with daughter
         art::Ptr<recob::PFParticle> pDaughter = pfParticleMap.at(daughterId);
-        const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pDaughter.key()));
+        const std::vector< art::Ptr<recob::Track> >& associatedTracks = cache.PfpTracks(pDaughter.key());
         if(associatedTracks.size() != 1) continue;
 
         // Get the first associated track
@@ -384,8 +376,7 @@ namespace sbnd {
         nuTracks.push_back(tpcTrack);
 
         // Truth match muon tracks and pfps
-        std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-        int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+        int trueId = cache.TrueId(tpcTrack.ID());
         if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trueId) != lepParticleIds.end()){ 
           type = "NuMuPfp";
         }
@@ -406,8 +397,8 @@ namespace sbnd {
                 return left.Length() > right.Length();});
 
       recob::Track tpcTrack = nuTracks[0];
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trackTrueID = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(tpcTrack.ID());
+      int trackTrueID = cache.TrueId(tpcTrack.ID());
 
       if(numCrtTrackMap.find(trackTrueID) != numCrtTrackMap.end()){
         hNumTrueMatches[type]->Fill(numCrtTrackMap[trackTrueID]);
@@ -416,8 +407,9 @@ namespace sbnd {
         hNumTrueMatches[type]->Fill(0);
       }
 
-      std::pair<crt::CRTTrack, double> closestAngle = trackAlg.ClosestCRTTrackByAngle(tpcTrack, crtTracks, event);
-      std::pair<crt::CRTTrack, double> closestDCA = trackAlg.ClosestCRTTrackByDCA(tpcTrack, crtTracks, event);
+      TPCGeoUtil::TrackSummary trackSummary = trackAlg.MakeTrackSummary(tpcTrack, hits);
+      std::pair<crt::CRTTrack, double> closestAngle = trackAlg.ClosestCRTTrackByAngle(trackSummary, crtTracks);
+      std::pair<crt::CRTTrack, double> closestDCA = trackAlg.ClosestCRTTrackByDCA(trackSummary, crtTracks);
 
       if(closestAngle.second != -99999){
         int crtTrackTrueID = fCrtBackTrack.TrueIdFromTotalEnergy(event, closestAngle.first);
@@ -456,7 +448,7 @@ namespace sbnd {
       }
 
       hLengthTotal[type]->Fill(tpcTrack.Length());
-      if(ctTag.CrtTrackCosmicId(tpcTrack, crtTracks, event)){
+      if(ctTag.CrtTrackCosmicId(tpcTrack, hits, crtTracks)){
         hLengthTag[type]->Fill(tpcTrack.Length());
       }
     }
@@ -9,6 +9,7 @@
 // sbndcode includes
 #include "sbndcode/RecoUtils/RecoUtils.h"
 #include "sbndcode/CosmicId/Utils/CosmicIdUtils.h"
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
 #include "sbndcode/CosmicId/Algs/CosmicIdAlg.h"
 #include "sbndcode/Geometry/GeometryWrappers/TPCGeoAlg.h"
 
@@ -140,6 +141,7 @@ namespace sbnd {
 
     CosmicIdAlg cosIdAlg;
     TPCGeoAlg fTpcGeo;
+    CosmicIdUtils::TruthFlashBuilder fTruthFlashes;
     // Momentum fitters
     trkf::TrajectoryMCSFitter     fMcsFitter; 
     trkf::TrackMomentumCalculator fRangeFitter;
@@ -240,10 +242,12 @@ namespace sbnd {
     //                                          GETTING PRODUCTS
     //----------------------------------------------------------------------------------------------------------
 
-    // Get truth info and matching
-    art::ServiceHandle<cheat::ParticleInventoryService> pi_serv;
-    // Retrieve all the truth info in the events
-    auto particleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fSimModuleLabel);
+    // Products and associations shared with the cosmic ID algorithm, resolved once per event
+    CosmicIdEventCache::Labels cacheLabels = cosIdAlg.EventCacheLabels();
+    cacheLabels.SimModule = fSimModuleLabel;
+    cacheLabels.TpcTrack  = fTpcTrackModuleLabel;
+    cacheLabels.Pandora   = fPandoraLabel;
+    CosmicIdEventCache cache(event, cacheLabels);
 
     // Get PFParticles from pandora
     PFParticleHandle pfParticleHandle;
@@ -254,33 +258,22 @@ namespace sbnd {
     }
     PFParticleIdMap pfParticleMap;
     this->GetPFParticleIdMap(pfParticleHandle, pfParticleMap);
-    // Get PFParticle to track associations
-    art::FindManyP< recob::Track > pfPartToTrackAssoc(pfParticleHandle, event, fTpcTrackModuleLabel);
-    
-    // Get track to hit and colorimetry associations
-    auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTpcTrackModuleLabel);
-    art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTpcTrackModuleLabel);
 
     //----------------------------------------------------------------------------------------------------------
     //                                          TRUTH MATCHING
     //----------------------------------------------------------------------------------------------------------
 
-    // Record all true particles and sort by type
-    std::map<int, simb::MCParticle> particles;
-    std::vector<simb::MCParticle> parts;
+    // Sort true particles by type
     std::vector<int> nuParticleIds;
     std::vector<int> lepParticleIds;
     std::vector<int> dirtParticleIds;
     std::vector<int> crParticleIds;
 
     // Loop over all true particles
-    for (auto const& particle: (*particleHandle)){
-      // Store particle
+    for (auto const& particle: cache.Particles()){
       int partId = particle.TrackId();
-      particles[partId] = particle;
-      parts.push_back(particle);
       // Get MCTruth
-      art::Ptr<simb::MCTruth> truth = pi_serv->TrackIdToMCTruth_P(partId);
+      art::Ptr<simb::MCTruth> truth = cache.Truth(partId);
       int pdg = std::abs(particle.PdgCode());
 
       // If origin is a neutrino
@@ -313,11 +306,13 @@ namespace sbnd {
     //----------------------------------------------------------------------------------------------------------
 
     // Create fake flashes in each tpc
-    std::pair<std::vector<double>, std::vector<double>> fakeFlashes = CosmicIdUtils::FakeTpcFlashes(parts);
-    std::vector<double> fakeTpc0Flashes = fakeFlashes.first;
-    std::vector<double> fakeTpc1Flashes = fakeFlashes.second;
-    bool tpc0BeamFlash = CosmicIdUtils::BeamFlash(fakeTpc0Flashes, fBeamTimeMin, fBeamTimeMax);
-    bool tpc1BeamFlash = CosmicIdUtils::BeamFlash(fakeTpc1Flashes, fBeamTimeMin, fBeamTimeMax);
+    std::pair<std::vector<double>, std::vector<double>> fakeFlashes = fTruthFlashes.Build(cache.Particles());
+    const std::vector<double>& fakeTpc0Flashes = fakeFlashes.first;
+    const std::vector<double>& fakeTpc1Flashes = fakeFlashes.second;
+    bool tpc0BeamFlash = CosmicIdUtils::BeamFlashSorted(fakeTpc0Flashes, fBeamTimeMin, fBeamTimeMax);
+    bool tpc1BeamFlash = CosmicIdUtils::BeamFlashSorted(fakeTpc1Flashes, fBeamTimeMin, fBeamTimeMax);
+    // Sort the flash times once for all of the cosmic ID calls
+    CosmicIdAlg::FlashTimes flashTimes = cosIdAlg.MakeFlashTimes(fakeTpc0Flashes, fakeTpc1Flashes);
 
     // If there are no flashes in time with the beam then ignore the event
     if(!tpc0BeamFlash && !tpc1BeamFlash) return;
@@ -346,7 +341,7 @@ namespace sbnd {
 
         // Get tracks associated with daughter
         art::Ptr<recob::PFParticle> pDaughter = pfParticleMap.at(daughterId);
-        const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pDaughter.key()));
+        const std::vector< art::Ptr<recob::Track> >& associatedTracks = cache.PfpTracks(pDaughter.key());
         if(associatedTracks.size() != 1) continue;
 
         // Get the first associated track
@@ -354,8 +349,7 @@ namespace sbnd {
         nuTracks.push_back(tpcTrack);
 
         // Truth match muon tracks and pfps
-        std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-        int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+        int trueId = cache.TrueId(tpcTrack.ID());
         int trackType = 3;
         if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trueId) != lepParticleIds.end()){ 
           trackType = 0;
@@ -374,13 +368,14 @@ namespace sbnd {
         }
         
         // Fill cut histograms per track
-        if(particles.find(trueId) != particles.end()){
+        const simb::MCParticle* trueParticle = cache.Particle(trueId);
+        if(trueParticle){
           // Only look at muons
-          if(std::abs(particles[trueId].PdgCode()) == 13){
+          if(std::abs(trueParticle->PdgCode()) == 13){
             // Calculate the true variables
-            std::pair<TVector3, TVector3> se = fTpcGeo.CrossingPoints(particles[trueId]);
-            double momentum = particles[trueId].P();
-            double length = fTpcGeo.TpcLength(particles[trueId]);
+            std::pair<TVector3, TVector3> se = fTpcGeo.CrossingPoints(*trueParticle);
+            double momentum = trueParticle->P();
+            double length = fTpcGeo.TpcLength(*trueParticle);
             double theta = (se.second-se.first).Theta();
             double phi = (se.second-se.first).Phi();
             // Switch on each cut individually
@@ -389,47 +384,47 @@ namespace sbnd {
               if(j == 0) plot = true;
               if(j == 1){
                 cosIdAlg.SetCuts(true, false, false, false, false, false, false, false, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 2){
                 cosIdAlg.SetCuts(false, true, false, false, false, false, false, false, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 3){
                 cosIdAlg.SetCuts(false, false, true, false, false, false, false, false, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 4){
 
                 cosIdAlg.SetCuts(false, false, false, true, false, false, false, false, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 5){
                 cosIdAlg.SetCuts(false, false, false, false, true, false, false, false, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 6){
                 cosIdAlg.SetCuts(false, false, false, false, false, true, false, false, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 7){
                 cosIdAlg.SetCuts(false, false, false, false, false, false, true, false, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 8){
                 cosIdAlg.SetCuts(false, false, false, false, false, false, false, true, false);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               if(j == 9){
                 cosIdAlg.SetCuts(false, false, false, false, false, false, false, false, true);
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
               // Return to the cuts specified in the fhicl file
               if(j == 10){
                 cosIdAlg.ResetCuts();
-                if(cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+                if(cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               }
-              if(j == 11 && !cosIdAlg.CosmicId(tpcTrack, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+              if(j == 11 && !cosIdAlg.CosmicId(tpcTrack, cache, flashTimes)) plot = true;
               if(!plot) continue;
               // Fill histograms if track ID'd as cosmic
               hTrueMom[trackType][j]->Fill(momentum);
@@ -469,64 +464,64 @@ namespace sbnd {
         if(j == 0) plot = true;
         if(j == 1){
           cosIdAlg.SetCuts(true, false, false, false, false, false, false, false, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){
             plot = true;
           }
         }
         if(j == 2){
           cosIdAlg.SetCuts(false, true, false, false, false, false, false, false, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         if(j == 3){
           cosIdAlg.SetCuts(false, false, true, false, false, false, false, false, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         if(j == 4){
           cosIdAlg.SetCuts(false, false, false, true, false, false, false, false, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         if(j == 5){
           cosIdAlg.SetCuts(false, false, false, false, true, false, false, false, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         if(j == 6){
           cosIdAlg.SetCuts(false, false, false, false, false, true, false, false, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         if(j == 7){
           cosIdAlg.SetCuts(false, false, false, false, false, false, true, false, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         if(j == 8){
           cosIdAlg.SetCuts(false, false, false, false, false, false, false, true, false);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         if(j == 9){
           cosIdAlg.SetCuts(false, false, false, false, false, false, false, false, true);
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
             plot = true;
           }
         }
         // Return to the cuts specified in the fhicl file
         if(j == 10){
           cosIdAlg.ResetCuts();
-          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)) plot = true;
+          if(cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)) plot = true;
         }
-        if(j == 11 && !cosIdAlg.CosmicId(*pParticle, pfParticleMap, event, fakeTpc0Flashes, fakeTpc1Flashes)){ 
+        if(j == 11 && !cosIdAlg.CosmicId(*pParticle, pfParticleMap, cache, flashTimes)){ 
           plot = true;
         }
         if(!plot) continue;
@@ -12,6 +12,7 @@
 #include "sbndcode/CRT/CRTProducts/CRTTrack.hh"
 #include "sbndcode/CRT/CRTUtils/CRTBackTracker.h"
 #include "sbndcode/CosmicId/Utils/CosmicIdUtils.h"
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
 #include "sbndcode/CosmicId/Algs/CosmicIdAlg.h"
 #include "sbndcode/Geometry/GeometryWrappers/TPCGeoAlg.h"
 
@@ -160,6 +161,7 @@ namespace sbnd {
     double fBeamTimeMax;
 
     TPCGeoAlg fTpcGeo;
+    CosmicIdUtils::TruthFlashBuilder fTruthFlashes;
 
     CRTBackTracker fCrtBackTrack;
 
@@ -342,15 +344,15 @@ namespace sbnd {
     //----------------------------------------------------------------------------------------------------------
     //                                          GETTING PRODUCTS
     //----------------------------------------------------------------------------------------------------------
-    // Get g4 particles
-    art::ServiceHandle<cheat::ParticleInventoryService> pi_serv;
-    auto particleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fSimModuleLabel);
-
-    // Get CRT hits from the event
-    art::Handle< std::vector<crt::CRTHit>> crtHitHandle;
-    std::vector<art::Ptr<crt::CRTHit> > crtHitList;
-    if (event.getByLabel(fCRTHitLabel, crtHitHandle))
-      art::fill_ptr_vector(crtHitList, crtHitHandle);
+    // Truth, tracks, associations and CRT products, resolved once per event
+    CosmicIdEventCache::Labels cacheLabels;
+    cacheLabels.SimModule = fSimModuleLabel;
+    cacheLabels.TpcTrack  = fTPCTrackLabel;
+    cacheLabels.Calo      = fCaloModuleLabel;
+    cacheLabels.Pandora   = fPandoraLabel;
+    cacheLabels.CrtHit    = fCRTHitLabel;
+    cacheLabels.CrtTrack  = fCRTTrackLabel;
+    CosmicIdEventCache cache(event, cacheLabels);
 
     // Initialize the CRT backtracker for speed
     fCrtBackTrack.Initialize(event);
@@ -359,41 +361,30 @@ namespace sbnd {
     std::vector<crt::CRTHit> crtHits;
     std::map<int, int> numHitMap;
     int hit_i = 0;
-    for(auto const& hit : (crtHitList)){
+    for(auto const& hit : cache.CrtHits()){
       // Don't try to match CRT hits in time with the beam
-      double hitTime = hit->ts1_ns * 1e-3;
+      double hitTime = hit.ts1_ns * 1e-3;
       if(hitTime > fBeamTimeMin && hitTime < fBeamTimeMax) continue;
-      crtHits.push_back(*hit);
+      crtHits.push_back(hit);
       int hitTrueID = fCrtBackTrack.TrueIdFromHitId(event, hit_i);
       hit_i++;
       numHitMap[hitTrueID]++;
     }
 
-    // Get CRT tracks from the event
-    art::Handle< std::vector<crt::CRTTrack>> crtTrackHandle;
-    std::vector<art::Ptr<crt::CRTTrack> > crtTrackList;
-    if (event.getByLabel(fCRTTrackLabel, crtTrackHandle))
-      art::fill_ptr_vector(crtTrackList, crtTrackHandle);
-
     // Loop over the CRT tracks and match them to true particles
     std::vector<crt::CRTTrack> crtTracks;
     std::map<int, int> numTrackMap;
     int track_i = 0;
-    for(auto const& track : (crtTrackList)){
+    for(auto const& track : cache.CrtTracks()){
       // Don't try to match CRT tracks in time with the beam
-      double trackTime = track->ts1_ns * 1e-3;
+      double trackTime = track.ts1_ns * 1e-3;
       if(trackTime > fBeamTimeMin && trackTime < fBeamTimeMax) continue;
-      crtTracks.push_back(*track);
+      crtTracks.push_back(track);
       int trackTrueID = fCrtBackTrack.TrueIdFromTrackId(event, track_i);
       track_i++;
       numTrackMap[trackTrueID]++;
     }
 
-    // Get reconstructed tracks from the event and hit/calorimetry associations
-    auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTPCTrackLabel);
-    art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTPCTrackLabel);
-    art::FindManyP<anab::Calorimetry> findManyCalo(tpcTrackHandle, event, fCaloModuleLabel);
-
     // Get PFParticles from pandora
     PFParticleHandle pfParticleHandle;
     event.getByLabel(fPandoraLabel, pfParticleHandle);
@@ -403,8 +394,7 @@ namespace sbnd {
     }
     PFParticleIdMap pfParticleMap;
     this->GetPFParticleIdMap(pfParticleHandle, pfParticleMap);
-    // Get PFParticle to track associations
-    art::FindManyP< recob::Track > pfPartToTrackAssoc(pfParticleHandle, event, fTPCTrackLabel);
+    // Get PFParticle metadata associations
     art::FindManyP<larpandoraobj::PFParticleMetadata> findManyPFPMetadata(pfParticleHandle,
         event, fPandoraLabel);
 
@@ -413,8 +403,6 @@ namespace sbnd {
     //----------------------------------------------------------------------------------------------------------
     
     // Sort the true particles by type
-    std::map<int, simb::MCParticle> particles;
-    std::vector<simb::MCParticle> parts;
     std::vector<int> nuParticleIds;
     std::vector<int> lepParticleIds;
     std::vector<int> dirtParticleIds;
@@ -422,15 +410,12 @@ namespace sbnd {
     // Record where the beam activity occurs
     int nuTpc = -2;
     // Loop over the true particles
-    for (auto const& particle: (*particleHandle)){
+    for (auto const& particle: cache.Particles()){
       
-      // Make map with ID
       int partID = particle.TrackId();
-      particles[partID] = particle;
-      parts.push_back(particle);
 
       // Get MCTruth
-      art::Ptr<simb::MCTruth> truth = pi_serv->TrackIdToMCTruth_P(partID);
+      art::Ptr<simb::MCTruth> truth = cache.Truth(partID);
       int pdg = std::abs(particle.PdgCode());
       double time = particle.T() * 1e-3; //[us]
 
@@ -477,11 +462,14 @@ namespace sbnd {
     //----------------------------------------------------------------------------------------------------------
 
     // Create fake flashes in each tpc
-    std::pair<std::vector<double>, std::vector<double>> fakeFlashes = CosmicIdUtils::FakeTpcFlashes(parts);
-    std::vector<double> fakeTpc0Flashes = fakeFlashes.first;
-    std::vector<double> fakeTpc1Flashes = fakeFlashes.second;
-    bool tpc0BeamFlash = CosmicIdUtils::BeamFlash(fakeTpc0Flashes, fBeamTimeMin, fBeamTimeMax);
-    bool tpc1BeamFlash = CosmicIdUtils::BeamFlash(fakeTpc1Flashes, fBeamTimeMin, fBeamTimeMax);
+    std::pair<std::vector<double>, std::vector<double>> fakeFlashes = fTruthFlashes.Build(cache.Particles());
+    const std::vector<double>& fakeTpc0Flashes = fakeFlashes.first;
+    const std::vector<double>& fakeTpc1Flashes = fakeFlashes.second;
+    bool tpc0BeamFlash = CosmicIdUtils::BeamFlashSorted(fakeTpc0Flashes, fBeamTimeMin, fBeamTimeMax);
+    bool tpc1BeamFlash = CosmicIdUtils::BeamFlashSorted(fakeTpc1Flashes, fBeamTimeMin, fBeamTimeMax);
+    // Sort the flash times once for the APA crossing search
+    ApaCrossCosmicIdAlg::FlashTimeIndex apaTpc0Flashes = ApaCrossCosmicIdAlg::MakeFlashTimeIndex(fakeTpc0Flashes);
+    ApaCrossCosmicIdAlg::FlashTimeIndex apaTpc1Flashes = ApaCrossCosmicIdAlg::MakeFlashTimeIndex(fakeTpc1Flashes);
 
     // If there are no flashes in time with the beam then ignore the event
     if(!tpc0BeamFlash && !tpc1BeamFlash) return;
@@ -514,7 +502,7 @@ namespace sbnd {
 
         // Get tracks associated with daughter
         art::Ptr<recob::PFParticle> pDaughter = pfParticleMap.at(daughterId);
-        const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pDaughter.key()));
+        const std::vector< art::Ptr<recob::Track> >& associatedTracks = cache.PfpTracks(pDaughter.key());
         if(associatedTracks.size() != 1) continue;
 
         // Get the first associated track
@@ -524,8 +512,7 @@ namespace sbnd {
         isPfpNu[tpcTrack.ID()] = isNeutrino;
 
         // Truth match muon tracks and pfps
-        std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-        int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+        int trueId = cache.TrueId(tpcTrack.ID());
         if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trueId) != lepParticleIds.end()){ 
           pfp_type = "NuMu";
         }
@@ -540,8 +527,7 @@ namespace sbnd {
         }
 
         // Get the TPC the pfp was detected in
-        std::vector<art::Ptr<recob::Hit>> tpcHits = findManyHits.at(tpcTrack.ID());
-        int tpc = fTpcGeo.DetectedInTPC(tpcHits);
+        int tpc = fTpcGeo.DetectedInTPC(cache.Hits(tpcTrack.ID()));
         if(tpc == pfp_tpc || pfp_tpc == -99999) pfp_tpc = tpc;
         else if(pfp_tpc != tpc) pfp_tpc = -1;
       }
@@ -557,16 +543,17 @@ namespace sbnd {
 
       // Choose longest track as cosmic muon candidate
       recob::Track tpcTrack = nuTracks[0];
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(tpcTrack.ID());
+      int trueId = cache.TrueId(tpcTrack.ID());
 
-      std::vector<art::Ptr<anab::Calorimetry>> calos = findManyCalo.at(tpcTrack.ID());
+      const std::vector<art::Ptr<anab::Calorimetry>>& calos = cache.Calos(tpcTrack.ID());
 
       // Get truth variables
-      if(particles.find(trueId) != particles.end()){
-        pfp_pdg = particles[trueId].PdgCode();
-        pfp_momentum = particles[trueId].P();
-        pfp_time = particles[trueId].T();
+      const simb::MCParticle* trueParticle = cache.Particle(trueId);
+      if(trueParticle){
+        pfp_pdg = trueParticle->PdgCode();
+        pfp_momentum = trueParticle->P();
+        pfp_time = trueParticle->T();
         // Does the true particle match any CRT hits or tracks?
         if(numHitMap.find(trueId) != numHitMap.end()){
           if(numHitMap[trueId] > 0) pfp_crt_hit_true_match = true;
@@ -575,10 +562,10 @@ namespace sbnd {
           if(numTrackMap[trueId] > 0) pfp_crt_track_true_match = true;
         }
         // Does particle stop in the TPC?
-        geo::Point_t end {particles[trueId].EndX(), particles[trueId].EndY(), particles[trueId].EndZ()};
+        geo::Point_t end {trueParticle->EndX(), trueParticle->EndY(), trueParticle->EndZ()};
         if(fTpcGeo.InFiducial(end, 0.)) pfp_stops = true;
         // Does the true particle cross the APA?
-        pfp_apa_cross = fTpcGeo.CrossesApa(particles[trueId]);
+        pfp_apa_cross = fTpcGeo.CrossesApa(*trueParticle);
         // Distance from the APA of the reco track at the true time
         pfp_apa_dist = fCosId.ApaAlg().ApaDistance(tpcTrack, pfp_time/1e3, hits); 
       }
@@ -610,25 +597,28 @@ namespace sbnd {
 
       }
 
+      // Summarise the track geometry once for all of the CRT matching
+      TPCGeoUtil::TrackSummary trackSummary = fCosId.CrtHitAlg().T0Alg().MakeTrackSummary(tpcTrack, hits);
+
       // CRT hit cut - get the distance of closest approach for the nearest CRT hit
-      std::pair<crt::CRTHit, double> closestHit = fCosId.CrtHitAlg().T0Alg().ClosestCRTHit(tpcTrack, crtHits, event);
+      std::pair<crt::CRTHit, double> closestHit = fCosId.CrtHitAlg().T0Alg().ClosestCRTHit(trackSummary, crtHits);
       pfp_crt_hit_dca = closestHit.second;
       if(useSecTrack){
-        std::pair<crt::CRTHit, double> closestSecHit = fCosId.CrtHitAlg().T0Alg().ClosestCRTHit(secTrack, crtHits, event);
+        std::pair<crt::CRTHit, double> closestSecHit = fCosId.CrtHitAlg().T0Alg().ClosestCRTHit(secTrack, cache.Hits(secTrack.ID()), crtHits);
         pfp_sec_crt_hit_dca = closestHit.second;
       }
 
       // CRT track cut - get the average distance of closest approach and angle between tracks for the nearest CRT track
-      std::pair<crt::CRTTrack, double> closestTrackDca = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByDCA(tpcTrack, crtTracks, event);
+      std::pair<crt::CRTTrack, double> closestTrackDca = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByDCA(trackSummary, crtTracks);
       pfp_crt_track_dca = closestTrackDca.second;
-      std::pair<crt::CRTTrack, double> closestTrackAngle = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByAngle(tpcTrack, crtTracks, event);
+      std::pair<crt::CRTTrack, double> closestTrackAngle = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByAngle(trackSummary, crtTracks);
       pfp_crt_track_angle = closestTrackAngle.second;
 
       // Stopping cut - get the chi2 ratio of the start and end of the track
       pfp_stop_ratio_start = fCosId.StoppingAlg().StoppingChiSq(tpcTrack.Vertex(), calos);
       pfp_stop_ratio_end = fCosId.StoppingAlg().StoppingChiSq(tpcTrack.End(), calos);
       if(useSecTrack){
-        std::vector<art::Ptr<anab::Calorimetry>> secCalos = findManyCalo.at(secTrack.ID());
+        const std::vector<art::Ptr<anab::Calorimetry>>& secCalos = cache.Calos(secTrack.ID());
         pfp_sec_stop_ratio_start = fCosId.StoppingAlg().StoppingChiSq(secTrack.Vertex(), secCalos);
         pfp_sec_stop_ratio_end = fCosId.StoppingAlg().StoppingChiSq(secTrack.End(), secCalos);
       }
@@ -642,11 +632,10 @@ namespace sbnd {
       }
 
       // APA cut - get the minimum distance to the APA at all PDS times
-      std::pair<double, double> ApaMin = fCosId.ApaAlg().MinApaDistance(tpcTrack, hits, fakeTpc0Flashes, fakeTpc1Flashes);
+      std::pair<double, double> ApaMin = fCosId.ApaAlg().MinApaDistance(tpcTrack, hits, apaTpc0Flashes, apaTpc1Flashes);
       pfp_apa_min_dist = ApaMin.first;
       if(useSecTrack){
-        std::vector<art::Ptr<recob::Hit>> secHits = findManyHits.at(secTrack.ID());
-        std::pair<double, double> ApaMin = fCosId.ApaAlg().MinApaDistance(secTrack, hits, fakeTpc0Flashes, fakeTpc1Flashes);
+        std::pair<double, double> ApaMin = fCosId.ApaAlg().MinApaDistance(secTrack, hits, apaTpc0Flashes, apaTpc1Flashes);
         pfp_sec_apa_min_dist = ApaMin.first;
       }
 
@@ -663,16 +652,16 @@ namespace sbnd {
     //----------------------------------------------------------------------------------------------------------
 
     // Loop over reconstructed tracks
-    for (auto const& tpcTrack : (*tpcTrackHandle)){
+    for (auto const& tpcTrack : cache.Tracks()){
 
       ResetTrackVars();
       track_nu_tpc = nuTpc;
 
       // Get the associated hits
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      const std::vector<art::Ptr<recob::Hit>>& hits = cache.Hits(tpcTrack.ID());
+      int trueId = cache.TrueId(tpcTrack.ID());
 
-      std::vector<art::Ptr<anab::Calorimetry>> calos = findManyCalo.at(tpcTrack.ID());
+      const std::vector<art::Ptr<anab::Calorimetry>>& calos = cache.Calos(tpcTrack.ID());
 
       // Determine the type of the track
       if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trueId) != lepParticleIds.end()) track_type = "NuMu";
@@ -686,10 +675,11 @@ namespace sbnd {
       }
 
       // Get truth variables
-      if(particles.find(trueId) != particles.end()){
-        track_pdg = particles[trueId].PdgCode();
-        track_momentum = particles[trueId].P();
-        track_time = particles[trueId].T();
+      const simb::MCParticle* trueParticle = cache.Particle(trueId);
+      if(trueParticle){
+        track_pdg = trueParticle->PdgCode();
+        track_momentum = trueParticle->P();
+        track_time = trueParticle->T();
         // Does the true particle match any CRT hits or tracks?
         if(numHitMap.find(trueId) != numHitMap.end()){
           if(numHitMap[trueId] > 0) track_crt_hit_true_match = true;
@@ -698,10 +688,10 @@ namespace sbnd {
           if(numTrackMap[trueId] > 0) track_crt_track_true_match = true;
         }
         // Does particle stop in the TPC?
-        geo::Point_t end {particles[trueId].EndX(), particles[trueId].EndY(), particles[trueId].EndZ()};
+        geo::Point_t end {trueParticle->EndX(), trueParticle->EndY(), trueParticle->EndZ()};
         if(fTpcGeo.InFiducial(end, 0.)) track_stops = true;
         // Does the true particle cross the APA?
-        track_apa_cross = fTpcGeo.CrossesApa(particles[trueId]);
+        track_apa_cross = fTpcGeo.CrossesApa(*trueParticle);
         // Distance from the APA of the reco track at the true time
         track_apa_dist = fCosId.ApaAlg().ApaDistance(tpcTrack, track_time/1e3, hits); 
       }
@@ -710,14 +700,17 @@ namespace sbnd {
       track_theta = tpcTrack.Theta();
       track_phi = tpcTrack.Phi();
 
+      // Summarise the track geometry once for all of the CRT matching
+      TPCGeoUtil::TrackSummary trackSummary = fCosId.CrtHitAlg().T0Alg().MakeTrackSummary(tpcTrack, hits);
+
       // CRT hit cut - get the distance of closest approach for the nearest CRT hit
-      std::pair<crt::CRTHit, double> closestHit = fCosId.CrtHitAlg().T0Alg().ClosestCRTHit(tpcTrack, crtHits, event);
+      std::pair<crt::CRTHit, double> closestHit = fCosId.CrtHitAlg().T0Alg().ClosestCRTHit(trackSummary, crtHits);
       track_crt_hit_dca = closestHit.second;
 
       // CRT track cut - get the average distance of closest approach and angle between tracks for the nearest CRT track
-      std::pair<crt::CRTTrack, double> closestTrackDca = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByDCA(tpcTrack, crtTracks, event);
+      std::pair<crt::CRTTrack, double> closestTrackDca = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByDCA(trackSummary, crtTracks);
       track_crt_track_dca = closestTrackDca.second;
-      std::pair<crt::CRTTrack, double> closestTrackAngle = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByAngle(tpcTrack, crtTracks, event);
+      std::pair<crt::CRTTrack, double> closestTrackAngle = fCosId.CrtTrackAlg().TrackAlg().ClosestCRTTrackByAngle(trackSummary, crtTracks);
       track_crt_track_angle = closestTrackAngle.second;
 
       // Stopping cut - get the chi2 ratio of the start and end of the track
@@ -732,14 +725,14 @@ namespace sbnd {
       track_tpc = fTpcGeo.DetectedInTPC(hits);
 
       // APA cut - get the minimum distance to the APA at all PDS times
-      std::pair<double, double> ApaMin = fCosId.ApaAlg().MinApaDistance(tpcTrack, hits, fakeTpc0Flashes, fakeTpc1Flashes);
+      std::pair<double, double> ApaMin = fCosId.ApaAlg().MinApaDistance(tpcTrack, hits, apaTpc0Flashes, apaTpc1Flashes);
       track_apa_min_dist = ApaMin.first;
 
       // The PFP Nu Score only exists for PFP Neutrinos
       if (track_pfp_nu){
         for(auto const pfp : (*pfParticleHandle)){
           // Get the associated track if there is one
-          const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pfp.Self()));
+          const std::vector< art::Ptr<recob::Track> >& associatedTracks = cache.PfpTracks(pfp.Self());
           if(associatedTracks.size() != 1) continue;
           recob::Track trk = *associatedTracks.front();
           if(trk.ID() != tpcTrack.ID()) continue;
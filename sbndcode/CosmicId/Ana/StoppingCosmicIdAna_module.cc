@@ -9,6 +9,7 @@
 // sbndcode includes
 #include "sbndcode/RecoUtils/RecoUtils.h"
 #include "sbndcode/CosmicId/Algs/StoppingParticleCosmicIdAlg.h"
+#include "sbndcode/CosmicId/Utils/CosmicIdEventCache.h"
 #include "sbndcode/Geometry/GeometryWrappers/TPCGeoAlg.h"
 
 // LArSoft includes
@@ -168,8 +169,6 @@ namespace sbnd {
 
   void StoppingCosmicIdAna::analyze(const art::Event& event)
   {
-    art::ServiceHandle<cheat::ParticleInventoryService> pi_serv;
-
     // Fetch basic event info
     if(fVerbose){
       std::cout<<"============================================"<<std::endl
@@ -181,15 +180,13 @@ namespace sbnd {
     //                                          GETTING PRODUCTS
     //----------------------------------------------------------------------------------------------------------
     
-    // Retrieve all the truth info in the events
-    auto particleHandle = event.getValidHandle<std::vector<simb::MCParticle>>(fSimModuleLabel);
-
-    // Retrieve the TPC tracks
-    auto tpcTrackHandle = event.getValidHandle<std::vector<recob::Track>>(fTpcTrackModuleLabel);
-
-    // Get track to hit associations
-    art::FindManyP<recob::Hit> findManyHits(tpcTrackHandle, event, fTpcTrackModuleLabel);
-    art::FindManyP<anab::Calorimetry> findManyCalo(tpcTrackHandle, event, fCaloModuleLabel);
+    // Truth, tracks and their hit/calorimetry associations, resolved once per event
+    CosmicIdEventCache::Labels cacheLabels;
+    cacheLabels.SimModule = fSimModuleLabel;
+    cacheLabels.TpcTrack  = fTpcTrackModuleLabel;
+    cacheLabels.Calo      = fCaloModuleLabel;
+    cacheLabels.Pandora   = fPandoraLabel;
+    CosmicIdEventCache cache(event, cacheLabels);
 
     // Get PFParticles from pandora
     PFParticleHandle pfParticleHandle;
@@ -200,27 +197,22 @@ namespace sbnd {
     }
     PFParticleIdMap pfParticleMap;
     this->GetPFParticleIdMap(pfParticleHandle, pfParticleMap);
-    // Get PFParticle to track associations
-    art::FindManyP< recob::Track > pfPartToTrackAssoc(pfParticleHandle, event, fTpcTrackModuleLabel);
 
     //----------------------------------------------------------------------------------------------------------
     //                                          TRUTH MATCHING
     //----------------------------------------------------------------------------------------------------------
     
-    std::map<int, simb::MCParticle> particles;
     std::vector<int> nuParticleIds;
     std::vector<int> lepParticleIds;
     std::vector<int> dirtParticleIds;
     std::vector<int> crParticleIds;
     // Loop over the true particles
-    for (auto const& particle: (*particleHandle)){
+    for (auto const& particle: cache.Particles()){
       
-      // Make map with ID
       int partID = particle.TrackId();
-      particles[partID] = particle;
 
       // Get MCTruth
-      art::Ptr<simb::MCTruth> truth = pi_serv->TrackIdToMCTruth_P(partID);
+      art::Ptr<simb::MCTruth> truth = cache.Truth(partID);
       int pdg = std::abs(particle.PdgCode());
 
       // If origin is a neutrino
@@ -252,11 +244,10 @@ namespace sbnd {
     //                                    STOPPING CHI2 ANALYSIS
     //----------------------------------------------------------------------------------------------------------
 
-    for(auto const& tpcTrack : (*tpcTrackHandle)){
+    for(auto const& tpcTrack : cache.Tracks()){
 
       // Match to the true particle
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      int trueId = cache.TrueId(tpcTrack.ID());
       std::string type = "none";
       if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trueId) != lepParticleIds.end()) type = "NuMuTrack";
       if(std::find(nuParticleIds.begin(), nuParticleIds.end(), trueId) != nuParticleIds.end()) type = "NuTrack";
@@ -264,13 +255,14 @@ namespace sbnd {
       if(std::find(dirtParticleIds.begin(), dirtParticleIds.end(), trueId) != dirtParticleIds.end()) type = "DirtTrack";
       if(type == "none") continue;
 
-      std::vector<art::Ptr<anab::Calorimetry>> calos = findManyCalo.at(tpcTrack.ID());
+      const std::vector<art::Ptr<anab::Calorimetry>>& calos = cache.Calos(tpcTrack.ID());
       if(calos.size()==0) continue;
 
       // Only focus on muon tracks or it'll be too hard
-      if(std::abs(particles[trueId].PdgCode()) != 13) continue;
+      const simb::MCParticle* trueParticle = cache.Particle(trueId);
+      if(!trueParticle || std::abs(trueParticle->PdgCode()) != 13) continue;
 
-      geo::Point_t trueEnd {particles[trueId].EndX(), particles[trueId].EndY(), particles[trueId].EndZ()};
+      geo::Point_t trueEnd {trueParticle->EndX(), trueParticle->EndY(), trueParticle->EndZ()};
       bool stops = false;
 
       if(fTPCGeo.InFiducial(trueEnd, 0.)) stops = true;
@@ -278,7 +270,7 @@ namespace sbnd {
       if(stops) hStopLength[type]->Fill(tpcTrack.Length());
       else hNoStopLength[type]->Fill(tpcTrack.Length());
 
-      TVector3 trueEndVec (particles[trueId].EndX(), particles[trueId].EndY(), particles[trueId].EndZ());
+      TVector3 trueEndVec (trueParticle->EndX(), trueParticle->EndY(), trueParticle->EndZ());
       TVector3 start = tpcTrack.Vertex<TVector3>();
       TVector3 end = tpcTrack.End<TVector3>();
       geo::Point_t recoEnd = tpcTrack.End();
@@ -328,7 +320,7 @@ namespace sbnd {
 
         // Get tracks associated with daughter
         art::Ptr<recob::PFParticle> pDaughter = pfParticleMap.at(daughterId);
-        const std::vector< art::Ptr<recob::Track> > associatedTracks(pfPartToTrackAssoc.at(pDaughter.key()));
+        const std::vector< art::Ptr<recob::Track> >& associatedTracks = cache.PfpTracks(pDaughter.key());
         if(associatedTracks.size() != 1) continue;
 
         // Get the first associated track
@@ -336,8 +328,7 @@ namespace sbnd {
         nuTracks.push_back(tpcTrack);
 
         // Truth match muon tracks and pfps
-        std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-        int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+        int trueId = cache.TrueId(tpcTrack.ID());
         if(std::find(lepParticleIds.begin(), lepParticleIds.end(), trueId) != lepParticleIds.end()){ 
           type = "NuMuPfp";
         }
@@ -358,16 +349,16 @@ namespace sbnd {
                 return left.Length() > right.Length();});
 
       recob::Track tpcTrack = nuTracks[0];
-      std::vector<art::Ptr<recob::Hit>> hits = findManyHits.at(tpcTrack.ID());
-      int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(hits, false);
+      int trueId = cache.TrueId(tpcTrack.ID());
 
-      std::vector<art::Ptr<anab::Calorimetry>> calos = findManyCalo.at(tpcTrack.ID());
+      const std::vector<art::Ptr<anab::Calorimetry>>& calos = cache.Calos(tpcTrack.ID());
       if(calos.size()==0) continue;
 
       // Only focus on muon tracks or it'll be too hard
-      if(std::abs(particles[trueId].PdgCode()) != 13) continue;
+      const simb::MCParticle* trueParticle = cache.Particle(trueId);
+      if(!trueParticle || std::abs(trueParticle->PdgCode()) != 13) continue;
 
-      geo::Point_t trueEnd {particles[trueId].EndX(), particles[trueId].EndY(), particles[trueId].EndZ()};
+      geo::Point_t trueEnd {trueParticle->EndX(), trueParticle->EndY(), trueParticle->EndZ()};
       bool stops = false;
 
       if(fTPCGeo.InFiducial(trueEnd, 0.)) stops = true;
@@ -375,7 +366,7 @@ namespace sbnd {
       if(stops) hStopLength[type]->Fill(tpcTrack.Length());
       else hNoStopLength[type]->Fill(tpcTrack.Length());
 
-      TVector3 trueEndVec (particles[trueId].EndX(), particles[trueId].EndY(), particles[trueId].EndZ());
+      TVector3 trueEndVec (trueParticle->EndX(), trueParticle->EndY(), trueParticle->EndZ());
       TVector3 start = tpcTrack.Vertex<TVector3>();
       TVector3 end = tpcTrack.End<TVector3>();
       geo::Point_t recoEnd = tpcTrack.End();
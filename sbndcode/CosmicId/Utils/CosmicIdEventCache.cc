@@ -0,0 +1,127 @@
+#include "CosmicIdEventCache.h"
+
+#include "larsim/MCCheater/ParticleInventoryService.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+
+namespace sbnd{
+
+  CosmicIdEventCache::CosmicIdEventCache(const art::Event& event, const Labels& labels)
+    : fEvent(event)
+    , fLabels(labels)
+  {
+  }
+
+  // =============================== TRUTH ==============================
+
+  void CosmicIdEventCache::FillTruth(){
+    if(fTruthFilled) return;
+    fParticles = fEvent.getValidHandle<std::vector<simb::MCParticle>>(fLabels.SimModule).product();
+    fParticleIndex.reserve(fParticles->size());
+    for(size_t i = 0; i < fParticles->size(); i++){
+      fParticleIndex.emplace((*fParticles)[i].TrackId(), i);
+    }
+    fTruthFilled = true;
+  }
+
+  const std::vector<simb::MCParticle>& CosmicIdEventCache::Particles(){
+    FillTruth();
+    return *fParticles;
+  }
+
+  const simb::MCParticle* CosmicIdEventCache::Particle(int trackId){
+    FillTruth();
+    auto it = fParticleIndex.find(trackId);
+    if(it == fParticleIndex.end()) return nullptr;
+    return &(*fParticles)[it->second];
+  }
+
+  art::Ptr<simb::MCTruth> CosmicIdEventCache::Truth(int trackId){
+    auto it = fTruth.find(trackId);
+    if(it != fTruth.end()) return it->second;
+    art::ServiceHandle<cheat::ParticleInventoryService> pi_serv;
+    art::Ptr<simb::MCTruth> truth = pi_serv->TrackIdToMCTruth_P(trackId);
+    fTruth.emplace(trackId, truth);
+    return truth;
+  }
+
+  simb::Origin_t CosmicIdEventCache::Origin(int trackId){
+    art::Ptr<simb::MCTruth> truth = Truth(trackId);
+    if(truth.isNull()) return simb::kUnknown;
+    return truth->Origin();
+  }
+
+  // =============================== TPC TRACKS ==============================
+
+  const std::vector<recob::Track>& CosmicIdEventCache::Tracks(){
+    if(!fTracks){
+      fTracks = fEvent.getValidHandle<std::vector<recob::Track>>(fLabels.TpcTrack).product();
+    }
+    return *fTracks;
+  }
+
+  const art::FindManyP<recob::Hit>& CosmicIdEventCache::FindManyHits(){
+    if(!fFindManyHits){
+      auto tpcTrackHandle = fEvent.getValidHandle<std::vector<recob::Track>>(fLabels.TpcTrack);
+      fFindManyHits = std::make_unique<art::FindManyP<recob::Hit>>(tpcTrackHandle, fEvent, fLabels.TpcTrack);
+    }
+    return *fFindManyHits;
+  }
+
+  const std::vector<art::Ptr<recob::Hit>>& CosmicIdEventCache::Hits(size_t trackId){
+    return FindManyHits().at(trackId);
+  }
+
+  const std::vector<art::Ptr<anab::Calorimetry>>& CosmicIdEventCache::Calos(size_t trackId){
+    if(!fFindManyCalo){
+      auto tpcTrackHandle = fEvent.getValidHandle<std::vector<recob::Track>>(fLabels.TpcTrack);
+      fFindManyCalo = std::make_unique<art::FindManyP<anab::Calorimetry>>(tpcTrackHandle, fEvent, fLabels.Calo);
+    }
+    return fFindManyCalo->at(trackId);
+  }
+
+  int CosmicIdEventCache::TrueId(size_t trackId){
+    auto it = fTrueIds.find(trackId);
+    if(it != fTrueIds.end()) return it->second;
+    int trueId = RecoUtils::TrueParticleIDFromTotalRecoHits(fTruthMatch, Hits(trackId), false);
+    fTrueIds.emplace(trackId, trueId);
+    return trueId;
+  }
+
+  // =============================== PFPARTICLES ==============================
+
+  const std::vector<art::Ptr<recob::Track>>& CosmicIdEventCache::PfpTracks(size_t pfpKey){
+    if(!fFindManyPfpTracks){
+      auto pfParticleHandle = fEvent.getValidHandle<std::vector<recob::PFParticle>>(fLabels.Pandora);
+      fFindManyPfpTracks = std::make_unique<art::FindManyP<recob::Track>>(pfParticleHandle, fEvent, fLabels.TpcTrack);
+    }
+    return fFindManyPfpTracks->at(pfpKey);
+  }
+
+  PandoraPfpIndex& CosmicIdEventCache::PfpIndex(const art::InputTag& pandoraLabel, const art::InputTag& trackLabel){
+    std::unique_ptr<PandoraPfpIndex>& index = fPfpIndices[std::make_pair(pandoraLabel.encode(), trackLabel.encode())];
+    if(!index) index = std::make_unique<PandoraPfpIndex>(fEvent, pandoraLabel, trackLabel);
+    return *index;
+  }
+
+  // =============================== CRT ==============================
+
+  // Missing CRT products are treated as empty, as the ana modules have always done
+  const std::vector<crt::CRTHit>& CosmicIdEventCache::CrtHits(){
+    if(!fCrtHits){
+      art::Handle<std::vector<crt::CRTHit>> crtHitHandle;
+      if(fEvent.getByLabel(fLabels.CrtHit, crtHitHandle)) fCrtHits = crtHitHandle.product();
+      else fCrtHits = &fNoCrtHits;
+    }
+    return *fCrtHits;
+  }
+
+  const std::vector<crt::CRTTrack>& CosmicIdEventCache::CrtTracks(){
+    if(!fCrtTracks){
+      art::Handle<std::vector<crt::CRTTrack>> crtTrackHandle;
+      if(fEvent.getByLabel(fLabels.CrtTrack, crtTrackHandle)) fCrtTracks = crtTrackHandle.product();
+      else fCrtTracks = &fNoCrtTracks;
+    }
+    return *fCrtTracks;
+  }
+
+}
@@ -0,0 +1,117 @@
+#ifndef COSMICIDEVENTCACHE_H_SEEN
+#define COSMICIDEVENTCACHE_H_SEEN
+
+
+///////////////////////////////////////////////
+// CosmicIdEventCache.h
+//
+// Per-event store of the products and associations used by the cosmic ID
+// ana modules and algorithms, everything is resolved on first use only
+///////////////////////////////////////////////
+
+// sbndcode
+#include "sbndcode/RecoUtils/RecoUtils.h"
+#include "sbndcode/CRT/CRTProducts/CRTHit.hh"
+#include "sbndcode/CRT/CRTProducts/CRTTrack.hh"
+#include "sbndcode/CosmicId/Utils/PandoraPfpIndex.h"
+
+// framework
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/FindManyP.h"
+#include "canvas/Utilities/InputTag.h"
+
+// LArSoft
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/AnalysisBase/Calorimetry.h"
+#include "nusimdata/SimulationBase/MCParticle.h"
+#include "nusimdata/SimulationBase/MCTruth.h"
+
+// c++
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <map>
+#include <string>
+
+namespace sbnd{
+
+  class CosmicIdEventCache {
+  public:
+
+    // Labels of the products the cache reads, only the ones that are used need to be set
+    struct Labels {
+      art::InputTag SimModule;
+      art::InputTag TpcTrack;
+      art::InputTag Calo;
+      art::InputTag Pandora;
+      art::InputTag CrtHit;
+      art::InputTag CrtTrack;
+    };
+
+    CosmicIdEventCache(const art::Event& event, const Labels& labels);
+
+    CosmicIdEventCache(const CosmicIdEventCache&) = delete;
+    CosmicIdEventCache& operator=(const CosmicIdEventCache&) = delete;
+
+    const art::Event& Event() const { return fEvent; }
+
+    // True particles and their generator truth, looked up once per track ID
+    const std::vector<simb::MCParticle>& Particles();
+    const simb::MCParticle* Particle(int trackId);
+    art::Ptr<simb::MCTruth> Truth(int trackId);
+    simb::Origin_t Origin(int trackId);
+
+    // TPC tracks and their associations, indexed by recob::Track::ID() as in the ana modules
+    const std::vector<recob::Track>& Tracks();
+    const art::FindManyP<recob::Hit>& FindManyHits();
+    const std::vector<art::Ptr<recob::Hit>>& Hits(size_t trackId);
+    const std::vector<art::Ptr<anab::Calorimetry>>& Calos(size_t trackId);
+
+    // Truth matched particle ID from the most reco hits (unsaved IDs not rolled up)
+    int TrueId(size_t trackId);
+
+    // Tracks associated to a PFParticle by key
+    const std::vector<art::Ptr<recob::Track>>& PfpTracks(size_t pfpKey);
+
+    // Pandora PFParticle hierarchy for the given PFParticle and track labels
+    PandoraPfpIndex& PfpIndex(const art::InputTag& pandoraLabel, const art::InputTag& trackLabel);
+
+    // Unfiltered CRT products straight from the event, empty if not found
+    const std::vector<crt::CRTHit>& CrtHits();
+    const std::vector<crt::CRTTrack>& CrtTracks();
+
+  private:
+
+    void FillTruth();
+
+    const art::Event& fEvent;
+    Labels fLabels;
+
+    const std::vector<simb::MCParticle>* fParticles = nullptr;
+    bool fTruthFilled = false;
+    std::unordered_map<int, size_t> fParticleIndex;
+    std::unordered_map<int, art::Ptr<simb::MCTruth>> fTruth;
+
+    const std::vector<recob::Track>* fTracks = nullptr;
+    std::unique_ptr<art::FindManyP<recob::Hit>> fFindManyHits;
+    std::unique_ptr<art::FindManyP<anab::Calorimetry>> fFindManyCalo;
+    std::unique_ptr<art::FindManyP<recob::Track>> fFindManyPfpTracks;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<PandoraPfpIndex>> fPfpIndices;
+
+    RecoUtils::TruthMatchCache fTruthMatch;
+    std::unordered_map<size_t, int> fTrueIds;
+
+    const std::vector<crt::CRTHit>* fCrtHits = nullptr;
+    const std::vector<crt::CRTTrack>* fCrtTracks = nullptr;
+    const std::vector<crt::CRTHit> fNoCrtHits;
+    const std::vector<crt::CRTTrack> fNoCrtTracks;
+
+  };
+
+}
+
+#endif
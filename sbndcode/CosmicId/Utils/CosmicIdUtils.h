@@ -20,15 +20,37 @@
 // c++
 #include <vector>
 #include <utility>
+#include <algorithm>
 
 namespace sbnd{
 namespace CosmicIdUtils{
 
+  // Builds fake PDS optical flashes from true particle energy deposits, the TPC
+  // bounds are looked up once so it can be kept for the whole job
+  class TruthFlashBuilder {
+  public:
+
+    TruthFlashBuilder();
+
+    // Time ordered flash times [us] in TPC 0 and TPC 1, flashes within 0.01 us are combined
+    std::pair<std::vector<double>, std::vector<double>> Build(const std::vector<simb::MCParticle>& particles) const;
+
+  private:
+
+    double fMinX, fMaxX, fMinY, fMaxY, fMinZ, fMaxZ;
+
+    void CombineFlashes(std::vector<double>& flashes) const;
+
+  };
+
   // Create fake PDS optical flashes from true particle energy deposits
-  std::pair<std::vector<double>, std::vector<double>> FakeTpcFlashes(std::vector<simb::MCParticle> particles);
+  std::pair<std::vector<double>, std::vector<double>> FakeTpcFlashes(const std::vector<simb::MCParticle>& particles);
 
   // Determine if there is a PDS flash in time with the neutrino beam
-  bool BeamFlash(std::vector<double> flashes, double beamTimeMin, double beamTimeMax);
+  bool BeamFlash(const std::vector<double>& flashes, double beamTimeMin, double beamTimeMax);
+
+  // Same for flash times that are already sorted, as returned by TruthFlashBuilder
+  bool BeamFlashSorted(const std::vector<double>& flashes, double beamTimeMin, double beamTimeMax);
   
 }
 }
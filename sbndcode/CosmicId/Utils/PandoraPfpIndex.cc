@@ -0,0 +1,101 @@
+#include "PandoraPfpIndex.h"
+
+#include <iostream>
+
+namespace sbnd{
+
+  PandoraPfpIndex::PandoraPfpIndex(const art::Event& event, const art::InputTag& pandoraLabel, const art::InputTag& trackLabel)
+    : fEvent(event)
+    , fPandoraLabel(pandoraLabel)
+  {
+
+    event.getByLabel(pandoraLabel, fPfpHandle);
+    fPfps = &(*fPfpHandle);
+    art::FindManyP<recob::Track> pfpTrackAssoc(fPfpHandle, event, trackLabel);
+
+    std::unordered_map<size_t, size_t> pfpPosition;
+    pfpPosition.reserve(fPfps->size());
+    for(size_t i = 0; i < fPfps->size(); i++){
+      pfpPosition.emplace((*fPfps)[i].Self(), i);
+    }
+
+    for(auto const& pfp : *fPfps){
+
+      // Track to PFParticle
+      const std::vector<art::Ptr<recob::Track>>& associatedTracks = pfpTrackAssoc.at(pfp.Self());
+      if(associatedTracks.size() == 1) fTrackPfps[associatedTracks.front()->ID()].push_back(pfp.Self());
+
+      // PFParticle to neutrino, everything passed on the way up shares the same one
+      std::vector<size_t> path;
+      size_t self = pfp.Self();
+      size_t neutrino = self;
+      while(true){
+        auto known = fNeutrino.find(self);
+        if(known != fNeutrino.end()){
+          neutrino = known->second;
+          break;
+        }
+        path.push_back(self);
+        const recob::PFParticle& current = (*fPfps)[pfpPosition.at(self)];
+        if(current.PdgCode() == 12 || current.PdgCode() == 14){
+          neutrino = self;
+          break;
+        }
+        auto parent = pfpPosition.find(current.Parent());
+        if(parent == pfpPosition.end()){
+          neutrino = self;
+          break;
+        }
+        self = current.Parent();
+      }
+      for(auto const& step : path) fNeutrino[step] = neutrino;
+    }
+
+  }
+
+  const std::vector<size_t>& PandoraPfpIndex::TrackPfps(int trackId) const{
+    auto it = fTrackPfps.find(trackId);
+    if(it == fTrackPfps.end()) return fNoPfps;
+    return it->second;
+  }
+
+  size_t PandoraPfpIndex::Neutrino(size_t pfpSelf) const{
+    return fNeutrino.at(pfpSelf);
+  }
+
+  float PandoraPfpIndex::NuScore(size_t pfpSelf){
+
+    auto it = fNuScore.find(pfpSelf);
+    if(it != fNuScore.end()) return it->second;
+
+    if(!fFindManyMetadata){
+      fFindManyMetadata = std::make_unique<art::FindManyP<larpandoraobj::PFParticleMetadata>>(fPfpHandle, fEvent, fPandoraLabel);
+    }
+
+    float nuScore = 99999;
+    const std::vector<art::Ptr<larpandoraobj::PFParticleMetadata>>& pfpMetaVec = fFindManyMetadata->at(pfpSelf);
+    if(pfpMetaVec.size() != 1){
+      std::cout<<"Cannot get PFPMetadata"<<std::endl;
+    }
+    else{
+      const larpandoraobj::PFParticleMetadata::PropertiesMap& propertiesMap = pfpMetaVec.front()->GetPropertiesMap();
+      auto propertiesMapIter = propertiesMap.find("NuScore");
+      if(propertiesMapIter == propertiesMap.end()){
+        std::cout<<"Cannot get PFP Nu Score in Metadata"<<std::endl;
+      }
+      else nuScore = propertiesMapIter->second;
+    }
+
+    fNuScore.emplace(pfpSelf, nuScore);
+    return nuScore;
+
+  }
+
+  const std::vector<art::Ptr<anab::T0>>& PandoraPfpIndex::T0s(size_t pfpSelf){
+    if(!fFindManyT0){
+      fFindManyT0 = std::make_unique<art::FindManyP<anab::T0>>(fPfpHandle, fEvent, fPandoraLabel);
+    }
+    return fFindManyT0->at(pfpSelf);
+  }
+
+}
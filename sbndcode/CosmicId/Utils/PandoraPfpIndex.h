@@ -0,0 +1,75 @@
+#ifndef PANDORAPFPINDEX_H_SEEN
+#define PANDORAPFPINDEX_H_SEEN
+
+
+///////////////////////////////////////////////
+// PandoraPfpIndex.h
+//
+// Per-event index of the Pandora PFParticle hierarchy, built in one pass:
+// track ID -> PFParticle -> neutrino at the top of the hierarchy, with the
+// NuScore and T0s of each PFParticle looked up on first use only
+///////////////////////////////////////////////
+
+// framework
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/FindManyP.h"
+#include "canvas/Utilities/InputTag.h"
+
+// LArSoft
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/PFParticleMetadata.h"
+#include "lardataobj/AnalysisBase/T0.h"
+
+// c++
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace sbnd{
+
+  // PFParticles are referred to by Self(), which the Pandora output also uses as the association index
+  class PandoraPfpIndex {
+  public:
+
+    PandoraPfpIndex(const art::Event& event, const art::InputTag& pandoraLabel, const art::InputTag& trackLabel);
+
+    PandoraPfpIndex(const PandoraPfpIndex&) = delete;
+    PandoraPfpIndex& operator=(const PandoraPfpIndex&) = delete;
+
+    const std::vector<recob::PFParticle>& PFParticles() const { return *fPfps; }
+
+    // PFParticles with exactly one associated track and that track has this ID, in collection order
+    const std::vector<size_t>& TrackPfps(int trackId) const;
+
+    // The first neutrino (PDG 12 or 14) up the hierarchy, or the last PFParticle reached if there is none
+    size_t Neutrino(size_t pfpSelf) const;
+
+    // NuScore from the PFParticle metadata, 99999 if it doesn't have one
+    float NuScore(size_t pfpSelf);
+
+    // T0s associated with the PFParticle
+    const std::vector<art::Ptr<anab::T0>>& T0s(size_t pfpSelf);
+
+  private:
+
+    const art::Event& fEvent;
+    art::InputTag fPandoraLabel;
+    art::Handle<std::vector<recob::PFParticle>> fPfpHandle;
+    const std::vector<recob::PFParticle>* fPfps;
+
+    std::unordered_map<int, std::vector<size_t>> fTrackPfps;
+    std::unordered_map<size_t, size_t> fNeutrino;
+    std::unordered_map<size_t, float> fNuScore;
+    const std::vector<size_t> fNoPfps;
+
+    std::unique_ptr<art::FindManyP<larpandoraobj::PFParticleMetadata>> fFindManyMetadata;
+    std::unique_ptr<art::FindManyP<anab::T0>> fFindManyT0;
+
+  };
+
+}
+
+#endif
@@ -33,11 +33,15 @@
 #include "CLHEP/Random/JamesRandom.h"
 #include "CLHEP/Random/RandFlat.h"
 
+#include "TH1D.h"
 #include "TH1F.h"
 #include "TRandom3.h"
 #include "TF1.h"
 #include "TMath.h"
+#include "TVirtualFFT.h"
 
+#include <map>
+#include <memory>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -61,20 +65,63 @@ public:
   ~SBNDNoiseServiceFromHist();
 
   // Add noise to a signal array.
-  int addNoise(Channel chan, AdcSignalVector& sigs) const;
+  int addNoise(Channel chan, AdcSignalVector& sigs) const override;
+
+  // Start of a new event, drop the noise waveform kept from the last one.
+  void generateNoise() override;
 
   // Print the configuration.
-  std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const;
+  std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const override;
 
 private:
+
+  // Histogram magnitude of each frequency bin and FFT buffers for an FFT size.
+  void makeNoiseTables(size_t nTicks) const;
+
+  // Two unit scale noise waveforms from one complex inverse FFT.
+  void makeNoisePair() const;
  
   // General parameters
-  unsigned int fNoiseArrayPoints;  ///< number of points in randomly generated noise array
-  int          fRandomSeed;        ///< Seed for random number service. If absent or zero, use SeedSvc.
-  int          fLogLevel;          ///< Log message level: 0=quiet, 1=init only, 2+=every event
-
+  unsigned int            fNoiseArrayPoints; ///< number of points in randomly generated noise array
+  int                     fRandomSeed;       ///< Seed for random number service. If absent or zero, use SeedSvc.
+  int                     fLogLevel;         ///< Log message level: 0=quiet, 1=init only, 2+=every event
+  std::map< double, int > fShapingTimeOrder;
+  double                  fNoiseWidth;       ///< exponential noise width (kHz)
+  double                  fNoiseRand;        ///< fraction of random "wiggle" in noise in freq. spectrum
+  double                  fLowCutoff;        ///< low frequency filter cutoff (kHz)
+  std::string             fNoiseHistoName;   ///< name of the noise frequency histogram
+  std::string             fNoiseFileFname;   ///< full path of the file holding the histogram
+  TH1D*                   fNoiseHist;        ///< noise frequency spectrum
+
+  // Cached services
+  const geo::GeometryCore* fGeometry;
+  art::ServiceHandle<util::LArFFT> fFFT;
+
+  // Noise factor (shaping time and ASIC gain) of each view, negative if the view has no channels
+  std::vector<double>     fViewNoiseFactor;
+
+  // Tables for the current FFT size, remade if the size changes
+  mutable size_t                       fNoiseTicks;     ///< FFT size the tables were made for
+  mutable std::vector<double>          fNoiseMagnitude; ///< histogram content of each frequency bin
+  mutable std::unique_ptr<TVirtualFFT> fInvFFT;         ///< complex to complex backward FFT
+  mutable std::vector<double>          fRandoms;
+  mutable std::vector<double>          fSpectrumRe;
+  mutable std::vector<double>          fSpectrumIm;
+  mutable std::vector<double>          fNoiseRe;        ///< unit scale noise for the next channel
+  mutable std::vector<double>          fNoiseIm;        ///< unit scale noise for the channel after that
+  mutable bool                         fHaveSpareNoise; ///< fNoiseIm not used yet
+
+  //Declare noise engines.
   CLHEP::HepRandomEngine* m_pran;
-
+  CLHEP::HepRandomEngine* fNoiseEngine;
+
+  // Function to allow use of noise engine in ChannelNoiseService setup.
+  void InitialiseProducerDeps(art::EDProducer * EDProdPointer, fhicl::ParameterSet const& pset) override{    
+    
+    CLHEP::HepRandomEngine& NoiseEngine((art::ServiceHandle<rndm::NuRandomService>{}->createEngine(*EDProdPointer,"HepJamesRandom","noise",pset,"Seed")));
+    fNoiseEngine = &NoiseEngine;
+    return; 
+  } 
 
 };
 
@@ -5,6 +5,14 @@
 
 #include "sbndcode/DetectorSim/Services/SBNDNoiseServiceFromHist.h"
 
+#include "larcore/CoreUtils/ServiceUtil.h"
+#include "canvas/Utilities/Exception.h"
+#include "cetlib/search_path.h"
+
+#include "TFile.h"
+
+#include <cmath>
+
 using std::cout;
 using std::ostream;
 using std::endl;
@@ -17,7 +25,8 @@ using CLHEP::HepJamesRandom;
 
 SBNDNoiseServiceFromHist::
 SBNDNoiseServiceFromHist(fhicl::ParameterSet const& pset)
-  : fRandomSeed(0), fLogLevel(1),  m_pran(nullptr), fNoiseEngine(nullptr)
+  : fRandomSeed(0), fLogLevel(1), fNoiseHist(nullptr), fNoiseTicks(0), fHaveSpareNoise(false),
+    m_pran(nullptr), fNoiseEngine(nullptr)
 {
   const string myname = "SBNDNoiseServiceFromHist::ctor: ";
   fNoiseArrayPoints  = pset.get<unsigned int>("NoiseArrayPoints");
@@ -30,10 +39,10 @@ SBNDNoiseServiceFromHist(fhicl::ParameterSet const& pset)
   fLowCutoff         = pset.get< double              >("LowCutoff");
   
   //Getting noise histo
-  fNoiseHistoName = p.get< std::string         >("NoiseHistoName");
+  fNoiseHistoName = pset.get< std::string         >("NoiseHistoName");
   
   cet::search_path sp("FW_SEARCH_PATH");
-  sp.find_file(p.get<std::string>("NoiseFileFname"), fNoiseFileFname);
+  sp.find_file(pset.get<std::string>("NoiseFileFname"), fNoiseFileFname);
   
   TFile in(fNoiseFileFname.c_str(), "READ");
   if (!in.IsOpen()) {
@@ -52,6 +61,31 @@ SBNDNoiseServiceFromHist(fhicl::ParameterSet const& pset)
   fNoiseHist->SetDirectory(nullptr);
   in.Close();
 
+  // The noise factor only depends on the view, through the noise table and the ASIC gain
+  double shapingTime = 2.0; //sss->GetShapingTime(chan);
+  if (fShapingTimeOrder.find( shapingTime ) == fShapingTimeOrder.end() ) {
+    throw cet::exception("SBNDNoiseServiceFromHist_service.cc")
+      << "\033[93m"
+      << "Shaping Time recieved from signalshapingservices_sbnd.fcl is not one of the allowed values"
+      << std::endl
+      << "Allowed values: 0.5, 1.0, 2.0, 3.0 us"
+      << "\033[00m"
+      << std::endl;
+  }
+
+  fGeometry = lar::providerFrom<geo::Geometry>();
+  art::ServiceHandle<util::SignalShapingServiceSBND> sss;
+  const auto& noiseFactVec = sss->GetNoiseFactVec();
+  size_t nViews = 0;
+  for (unsigned int chan = 0; chan < fGeometry->Nchannels(); ++chan) {
+    size_t view = (size_t)fGeometry->View(chan);
+    if (view < fViewNoiseFactor.size() && fViewNoiseFactor[view] >= 0) continue;
+    if (view >= fViewNoiseFactor.size()) fViewNoiseFactor.resize(view + 1, -1.);
+    fViewNoiseFactor[view] = noiseFactVec[view].at( fShapingTimeOrder.find( shapingTime )->second )
+                             * sss->GetASICGain(chan)/4.7;
+    if (++nViews == noiseFactVec.size()) break;
+  }
+
 
   if ( fRandomSeed == 0 ) haveSeed = false;
   pset.get_if_present<int>("LogLevel", fLogLevel);
@@ -93,39 +127,13 @@ SBNDNoiseServiceFromHist::~SBNDNoiseServiceFromHist() {
 
 int SBNDNoiseServiceFromHist::addNoise(Channel chan, AdcSignalVector& sigs) const {
 
-  //Get services.
-  art::ServiceHandle<geo::Geometry> geo;
-  art::ServiceHandle<util::SignalShapingServiceSBND> sss;
-  art::ServiceHandle<util::LArFFT> fFFT;
-  
-  //Generate Noise:
-  size_t view = (size_t)geo->View(chan);
-  
-  double noise_factor;
-  auto tempNoiseVec = sss->GetNoiseFactVec();
-  double shapingTime = 2.0; //sss->GetShapingTime(chan);
-  double asicGain = sss->GetASICGain(chan);
-
-  size_t fNTicks = fFFT->FFTSize();
-
-  
-  if (fShapingTimeOrder.find( shapingTime ) != fShapingTimeOrder.end() ) {
-    noise_factor = tempNoiseVec[view].at( fShapingTimeOrder.find( shapingTime )->second );
-    noise_factor *= asicGain/4.7;
-  }
-  else {
+  size_t view = (size_t)fGeometry->View(chan);
+  if (view >= fViewNoiseFactor.size() || fViewNoiseFactor[view] < 0)
     throw cet::exception("SBNDNoiseServiceFromHist_service.cc")
-      << "\033[93m"
-      << "Shaping Time recieved from signalshapingservices_sbnd.fcl is not one of the allowed values"
-      << std::endl
-      << "Allowed values: 0.5, 1.0, 2.0, 3.0 us"
-      << "\033[00m"
-      << std::endl;
-  }
-
-  
-  CLHEP::RandFlat flat(*fNoiseEngine, -1, 1);
+        << "No noise factor for view " << view << " of channel " << chan << std::endl;
+  double noise_factor = fViewNoiseFactor[view];
 
+  size_t fNTicks = fFFT->FFTSize();
 
   if (sigs.size() != fNTicks)
     throw cet::exception("SBNDNoiseServiceFromHist_service.cc")
@@ -135,40 +143,96 @@ int SBNDNoiseServiceFromHist::addNoise(Channel chan, AdcSignalVector& sigs) cons
         << "\033[00m"
         << std::endl;
 
-  // noise in frequency space
-  std::vector<TComplex> noiseFrequency(fNTicks / 2 + 1, 0.);
+  if (fNTicks != fNoiseTicks) makeNoiseTables(fNTicks);
+
+  // Each inverse FFT makes the noise for two channels
+  const std::vector<double>* noise = &fNoiseIm;
+  if (fHaveSpareNoise) {
+    fHaveSpareNoise = false;
+  } else {
+    makeNoisePair();
+    noise = &fNoiseRe;
+    fHaveSpareNoise = true;
+  }
+
+  for (size_t i = 0; i < fNTicks; ++i) {
+    sigs[i] = noise_factor * (*noise)[i];
+  }
+
+  return 0;
+}
+
+//**********************************************************************
+
+void SBNDNoiseServiceFromHist::generateNoise() {
+  fHaveSpareNoise = false;
+}
+
+//**********************************************************************
 
-  double pval = 0.;
-  double lofilter = 0.;
-  double phase = 0.;
-  double rnd[2] = {0.};
+void SBNDNoiseServiceFromHist::makeNoiseTables(size_t nTicks) const {
 
-  // width of frequencyBin in kHz
-  double binWidth = 1.0 / (fNTicks * fSampleRate * 1.0e-6);
+  fNoiseTicks = nTicks;
 
-  for (size_t i = 0; i < fNTicks / 2 + 1; ++i) {
-    // exponential noise spectrum
-    flat.fireArray(2, rnd, 0, 1);
-    pval = fNoiseHist->GetBinContent(i) * ((1 - fNoiseRand) + 2 * fNoiseRand * rnd[0]) * noise_factor;
-    phase = rnd[1] * 2.*TMath::Pi();
-    TComplex tc(pval * cos(phase), pval * sin(phase));
-    noiseFrequency.at(i) += tc;
+  size_t nBins = fNoiseTicks / 2 + 1;
+  fNoiseMagnitude.resize(nBins);
+  for (size_t i = 0; i < nBins; ++i) {
+    fNoiseMagnitude[i] = fNoiseHist->GetBinContent(i);
   }
 
+  Int_t n = fNoiseTicks;
+  fInvFFT.reset(TVirtualFFT::FFT(1, &n, "C2CBACKWARD M K"));
+
+  fRandoms.resize(4 * nBins);
+  fSpectrumRe.assign(fNoiseTicks, 0.);
+  fSpectrumIm.assign(fNoiseTicks, 0.);
+  fNoiseRe.resize(fNoiseTicks);
+  fNoiseIm.resize(fNoiseTicks);
+  fHaveSpareNoise = false;
+}
 
-  // inverse FFT MCSignal
-  fFFT->DoInvFFT(noiseFrequency, sigs);
+//**********************************************************************
 
-  noiseFrequency.clear();
+void SBNDNoiseServiceFromHist::makeNoisePair() const {
 
-  // multiply each noise value by fNTicks as the InvFFT
-  // divides each bin by fNTicks assuming that a forward FFT
-  // has already been done.
-  for (unsigned int i = 0; i < sigs.size(); ++i) {
-    sigs.at(i) *= 1.*fNTicks;
+  size_t nBins = fNoiseTicks / 2 + 1;
+
+  // Magnitude wiggle and phase of every bin for both waveforms
+  CLHEP::RandFlat flat(*fNoiseEngine, -1, 1);
+  flat.fireArray(4 * nBins, fRandoms.data(), 0, 1);
+
+  for (size_t i = 0; i < nBins; ++i) {
+    const double* rnd = &fRandoms[4 * i];
+    double pvalA  = fNoiseMagnitude[i] * ((1 - fNoiseRand) + 2 * fNoiseRand * rnd[0]);
+    double phaseA = rnd[1] * 2.*TMath::Pi();
+    double pvalB  = fNoiseMagnitude[i] * ((1 - fNoiseRand) + 2 * fNoiseRand * rnd[2]);
+    double phaseB = rnd[3] * 2.*TMath::Pi();
+
+    double reA = pvalA * cos(phaseA);
+    double imA = pvalA * sin(phaseA);
+    double reB = pvalB * cos(phaseB);
+    double imB = pvalB * sin(phaseB);
+
+    // A real waveform has no imaginary part at zero and Nyquist frequency
+    bool selfConjugate = (i == 0 || 2 * i == fNoiseTicks);
+    if (selfConjugate) {
+      imA = 0.;
+      imB = 0.;
+    }
+
+    // Spectrum of a + ib is A + iB at positive frequencies and conj(A) + i conj(B) at negative
+    fSpectrumRe[i] = reA - imB;
+    fSpectrumIm[i] = imA + reB;
+    if (!selfConjugate) {
+      fSpectrumRe[fNoiseTicks - i] = reA + imB;
+      fSpectrumIm[fNoiseTicks - i] = reB - imA;
+    }
   }
 
-  return 0;
+  // Unnormalised, as the noise spectrum is in the same units as the output
+  fInvFFT->SetPointsComplex(fSpectrumRe.data(), fSpectrumIm.data());
+  fInvFFT->Transform();
+  fInvFFT->GetPointsComplex(fNoiseRe.data(), fNoiseIm.data());
 }
 
 
@@ -7,6 +7,8 @@
 #include "art_root_io/TFileService.h"
 #include "TH1.h"
 #include <bitset>
+#include <algorithm>
+#include <vector>
 
 
 //  class CRTTrigFilter : public art::EDFilter(fhicl::ParameterSet const& p) {
@@ -43,6 +45,25 @@
    float    fTimeCoinc;
    float    fADCthresh;
 
+   // faces in the order of the module lists
+   static const int kNFaces = 8;
+   // plane bits a strip adds to each face, indexed by ((module*16)+strip)*kNFaces+face
+   std::vector<uint64_t> fFaceBits;
+   std::vector<bool> fModuleOnFace;  // module is in at least one list
+   uint64_t fEdgeCutL, fEdgeCutR;
+
+   struct StripPair {
+     size_t index;   // position in the strip list
+     int module;
+     int strip;
+     float ctime;    // in us
+   };
+   std::vector<StripPair> fStrips;
+
+   void FillFaceBits();
+   const uint64_t* FaceBits(int module, int strip) const;
+   bool MatchStrips(const StripPair& s1, const StripPair& s2) const;
+
 
    TH1F *hits;
    TH1F *trigt;
@@ -81,6 +102,97 @@
     if (fedgecut>31) fedgecut=31;
     fTimeCoinc = p.get<float>("StripTimeCoincidence",0.2);
     fADCthresh = p.get<float>("ADCthresh",500.0);
+
+    fEdgeCutR = ~((uint64_t)(pow(2,fedgecut)-1) | ((uint64_t)(pow(2,32)-1)<< 32));
+    fEdgeCutL = ~(((uint64_t)(pow(2,fedgecut)-1) << (32-fedgecut))| ((uint64_t)(pow(2,32)-1) <<32));
+    //    std::cout << "left " << std::bitset<64>(fEdgeCutL) << " right " << std::bitset<64>(fEdgeCutR) << std::endl;
+    //  left  0000000000000000000000000000000000000000000011111111111111111111 
+    //  right 0000000000000000000000000000000011111111111111111111000000000000
+
+    FillFaceBits();
+  }
+
+  // Work out once what every (module, strip) adds to each face plane, instead of
+  // scanning all the module lists for every coincident pair
+  void CRTTrigFilter::FillFaceBits()
+  {
+    const std::vector<int>* modlists[kNFaces] = {&fmodlistUTopL, &fmodlistUBotL, &fmodlistUTopR, &fmodlistUBotR,
+                                                 &fmodlistDTopL, &fmodlistDBotL, &fmodlistDTopR, &fmodlistDBotR};
+    int maxmodule = -1;
+    for (int face=0;face<kNFaces;++face) {
+      for (auto const& module : *modlists[face]) maxmodule = std::max(maxmodule, module);
+    }
+    fFaceBits.assign((maxmodule+1)*16*kNFaces, 0);
+    fModuleOnFace.assign(maxmodule+1, false);
+    for (int face=0;face<kNFaces;++face) {
+      const std::vector<int>& modlist = *modlists[face];
+      for (size_t im=0;im<modlist.size();++im) {
+        if (modlist[im]<0) continue;
+        size_t iswap = modlist.size()-im-1;
+        fModuleOnFace[modlist[im]] = true;
+        // same int arithmetic the per pair sums have always used
+        for (int strip=0;strip<16;++strip) {
+          fFaceBits[((modlist[im]*16)+strip)*kNFaces+face] += (1 << ((15-strip)+iswap*16));
+        }
+      }
+    }
+  }
+
+  const uint64_t* CRTTrigFilter::FaceBits(int module, int strip) const
+  {
+    if (module<0 || module>=(int)fModuleOnFace.size() || !fModuleOnFace[module]) return nullptr;
+    return &fFaceBits[((module*16)+strip)*kNFaces];
+  }
+
+  // Trigger condition for two coincident strips, s1 is the earlier in the strip list
+  bool CRTTrigFilter::MatchStrips(const StripPair& s1, const StripPair& s2) const
+  {
+    const uint64_t* bits1 = FaceBits(s1.module, s1.strip);
+    const uint64_t* bits2 = FaceBits(s2.module, s2.strip);
+    if (!bits1 && !bits2) return false;
+
+    uint64_t plane[kNFaces];
+    for (int face=0;face<kNFaces;++face) {
+      plane[face] = (bits1 ? bits1[face] : 0) + (bits2 ? bits2[face] : 0);
+    }
+    uint64_t planeUpStL = plane[0] | plane[1];
+    uint64_t planeUpStR = plane[2] | plane[3];
+    uint64_t planeDownStL = plane[4] | plane[5];
+    uint64_t planeDownStR = plane[6] | plane[7];
+
+    bool match = false;
+    if ((planeUpStR & fEdgeCutR) && (planeDownStR & fEdgeCutR)) {
+      if ( planeUpStR & planeDownStR ) match=true;
+      for (int is=1;is<=fstripshift && !match;++is) {
+	if ((planeUpStR << is) & planeDownStR) match=true;
+	if ((planeDownStR << is) & planeUpStR)  match=true;
+      }
+    }
+    if (!match && (planeUpStL & fEdgeCutL) && (planeDownStL & fEdgeCutL)) {
+      if ( planeUpStL & planeDownStL ) match=true;
+      for (int is=1;is<=fstripshift && !match;++is) {
+	if ((planeUpStL << is) & planeDownStL) match=true;
+	if ((planeDownStL << is) & planeUpStL)  match=true;
+      }
+    }
+    if (!match) return false;
+
+    float stripwidth = 11.2; //cm
+    float driftvel = 0.16;  //cm/us
+
+    // set cut limits on drift window time expectation of track from CRT hit.
+    float rwcut = fedgecut*stripwidth/driftvel;
+    float rwcutlow = -200.0 - rwcut;
+    float rwcuthigh = 1500.00 + rwcut;
+
+    float xpos;  // in cm
+    if (s1.module<s2.module) xpos=((int(s1.module/2)-20)*16+s1.strip+0.5)*stripwidth-358.4;
+    else xpos=((int(s2.module/2)-20)*16+s2.strip+0.5)*stripwidth-358.4;
+    float dtime;  // in us
+    if (xpos>0) dtime = s1.ctime+((200.0-xpos)/driftvel);
+    else dtime = s1.ctime+((200.0+xpos)/driftvel);
+    if (dtime<rwcutlow || dtime>rwcuthigh ) return false;
+    return true;
   }
 
   bool CRTTrigFilter::filter(art::Event& e)
@@ -89,164 +201,53 @@
     bool KeepMe = false;
     int event = e.id().event();
     if (event%1000==0) std::cout << "event " << event << std::endl;
-    //    unsigned long long planeUtop, planeUbot, planeDtop, planeDbot;
-    uint64_t planeUtopL, planeUbotL, planeDtopL, planeDbotL;
-    uint64_t planeUtopR, planeUbotR, planeDtopR, planeDbotR;
-    uint64_t planeUpStL, planeDownStL;
-    uint64_t planeUpStR, planeDownStR;
-
-    //    uint64 planeUpSt,planeDownSt;
 
     int nstr=0;
     art::Handle<std::vector<sbnd::crt::CRTData> > crtStripListHandle;
     std::vector<art::Ptr<sbnd::crt::CRTData> > striplist;
     if (e.getByLabel(fCRTStripModuleLabel, crtStripListHandle))  {
-      //    if (e.getByLabel("crt", crtStripListHandle))  {
       art::fill_ptr_vector(striplist, crtStripListHandle);
       nstr = striplist.size();
     }
     //    std::cout << "number of crt strips " << nstr << std::endl;
     
     bool trigKeep = false;   
-    uint64_t edgecutL,edgecutR;
-    edgecutR = ~((uint64_t)(pow(2,fedgecut)-1) | ((uint64_t)(pow(2,32)-1)<< 32));
-    edgecutL = ~(((uint64_t)(pow(2,fedgecut)-1) << (32-fedgecut))| ((uint64_t)(pow(2,32)-1) <<32));
-    //    std::cout << "left " << std::bitset<64>(edgecutL) << " right " << std::bitset<64>(edgecutR) << std::endl;
-    //  left  0000000000000000000000000000000000000000000011111111111111111111 
-    //  right 0000000000000000000000000000000011111111111111111111000000000000
-    
-    float stripwidth = 11.2; //cm
-    float driftvel = 0.16;  //cm/us
 
-    // set cut limits on drift window time expectation of track from CRT hit.
-    float rwcut = fedgecut*stripwidth/driftvel;
-    float rwcutlow = -200.0 - rwcut;
-    float rwcuthigh = 1500.00 + rwcut;
-
-    for (int i = 0; i<nstr-2; i+=2){
+    // Strips come as pairs of sipms, keep those above threshold
+    fStrips.clear();
+    for (int i = 0; i+1<nstr; i+=2){
       if ((striplist[i]->ADC()+striplist[i+1]->ADC())>fADCthresh) { 
-	uint32_t chan1 = striplist[i]->Channel();
-	int strip1 = (chan1 >> 1) & 15;
-	int module1 = (chan1>> 5);
-	uint32_t ttime1 = striplist[i]->T0();
-	float ctime1 = ttime1/16.;
-	if (ttime1 > 2147483648) {
-	  ctime1 = ((ttime1-4294967296)/16.);
+	uint32_t chan = striplist[i]->Channel();
+	//  T0 in units of ticks, but clock frequency (16 ticks = 1 us) is wrong.
+	// ints were stored as uints, need to patch this up
+	uint32_t ttime = striplist[i]->T0();
+	float ctime = ttime/16.;
+	if (ttime > 2147483648) {
+	  ctime = ((ttime-4294967296)/16.);
 	}
+	fStrips.push_back({(size_t)i, (int)(chan >> 5), (int)((chan >> 1) & 15), ctime});
+      }
+    }
 
-	//
-	for (int j = i+2; j<nstr; j+=2){
-	  if ((striplist[j]->ADC()+striplist[j+1]->ADC())>fADCthresh) { 	
-	  bool match = false;
-	  uint32_t chan2 = striplist[j]->Channel();
-	  int strip2 = (chan2 >> 1) & 15;
-	  int module2 = (chan2>> 5);
-	  //
-	  uint32_t ttime2 = striplist[j]->T0();
-	  //  T0 in units of ticks, but clock frequency (16 ticks = 1 us) is wrong.
-	  // ints were stored as uints, need to patch this up
-	  float ctime2 = ttime2/16.;
-	  if (ttime2 > 2147483648) {
-	    ctime2 = ((ttime2-4294967296)/16.);
-	  }
-	  //
-	  float diff = abs(ctime1-ctime2);
-	  //	  if (diff<=fTimeCoinc && ctime1>-1300 && ctime1<1300) {
-	  if (diff<=fTimeCoinc ) {
-	    
-	    
-	    planeUtopL=0; planeUbotL=0; planeDtopL=0; planeDbotL=0;
-	    planeUtopR=0; planeUbotR=0; planeDtopR=0; planeDbotR=0;
-	    for (size_t im=0;im<fmodlistUTopL.size();++im) {
-	      size_t iswap = fmodlistUTopL.size()-im-1;
-	      if (module1==fmodlistUTopL[im]) planeUtopL+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistUTopL[im]) planeUtopL+=(1 << ((15-strip2)+iswap*16));
-	    }	
-	    for (size_t im=0;im<fmodlistUBotL.size();++im) {
-	      size_t iswap = fmodlistUBotL.size()-im-1;
-	      if (module1==fmodlistUBotL[im]) planeUbotL+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistUBotL[im]) planeUbotL+=(1 << ((15-strip2)+iswap*16));
-	    }	
-	    for (size_t im=0;im<fmodlistUTopR.size();++im) {
-	      size_t iswap = fmodlistUTopR.size()-im-1;
-	      if (module1==fmodlistUTopR[im]) planeUtopR+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistUTopR[im]) planeUtopR+=(1 << ((15-strip2)+iswap*16));
-	    }	
-	    for (size_t im=0;im<fmodlistUBotR.size();++im) {
-	      size_t iswap = fmodlistUBotR.size()-im-1;
-	      if (module1==fmodlistUBotR[im]) planeUbotR+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistUBotR[im]) planeUbotR+=(1 << ((15-strip2)+iswap*16));
-	    }	
-	    for (size_t im=0;im<fmodlistDTopL.size();++im) {
-	      size_t iswap = fmodlistDTopL.size()-im-1;
-	      if (module1==fmodlistDTopL[im]) planeDtopL+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistDTopL[im]) planeDtopL+=(1 << ((15-strip2)+iswap*16));
-	    }	
-	    for (size_t im=0;im<fmodlistDBotL.size();++im) {
-	      size_t iswap = fmodlistDBotL.size()-im-1;
-	      if (module1==fmodlistDBotL[im]) planeDbotL+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistDBotL[im]) planeDbotL+=(1 << ((15-strip2)+iswap*16));
-	    }	
-	    for (size_t im=0;im<fmodlistDTopR.size();++im) {
-	      size_t iswap = fmodlistDTopR.size()-im-1;
-	      if (module1==fmodlistDTopR[im]) planeDtopR+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistDTopR[im]) planeDtopR+=(1 << ((15-strip2)+iswap*16));
-	    }	
-	    for (size_t im=0;im<fmodlistDBotR.size();++im) {
-	      size_t iswap = fmodlistDBotR.size()-im-1;
-	      if (module1==fmodlistDBotR[im]) planeDbotR+=(1 << ((15-strip1)+iswap*16));
-	      if (module2==fmodlistDBotR[im]) planeDbotR+=(1 << ((15-strip2)+iswap*16));
-	    }	
-
-	    planeUpStL = planeUtopL | planeUbotL;
-	    planeUpStR = planeUtopR | planeUbotR;
-	    planeDownStL = planeDtopL | planeDbotL;
-	    planeDownStR = planeDtopR | planeDbotR;
-	    if ((planeUpStR & edgecutR) && (planeDownStR & edgecutR)) {
-
-	      if ( planeUpStR & planeDownStR ) match=true;
-	      for (int is=1;is<=fstripshift;++is) {
-		uint64_t temp; temp=(planeUpStR << is);
-		if (temp & planeDownStR) match=true;
-		temp=(planeDownStR << is);
-		if (temp & planeUpStR)  match=true;
-	      }
-	    }
-	    if ((planeUpStL & edgecutL) && (planeDownStL & edgecutL)) {
-	      if ( planeUpStL & planeDownStL ) match=true;
-	      for (int is=1;is<=fstripshift;++is) {
-		uint64_t temp; temp=(planeUpStL << is);
-		if (temp & planeDownStL) match=true;
-		temp=(planeDownStL << is);
-		if (temp & planeUpStL)  match=true;
-	      }
-	    }
-	    if (match) {
-	      // std::cout << " before drift window cut " << std::endl;
-	      // std::cout << " module and strip 1 " << module1 << " " << strip1 << std::endl;
-	      // std::cout << " module and strip 2 " << module2 << " " << strip2 << std::endl;
-	      // std::cout << "  upstream " << std::bitset<64>(planeUpStR) <<
-	      // 	std::endl << "downstream " << std::bitset<64>(planeDownStR) << 
-	      // 	std::endl;
-	      // std::cout << " ----------------------------------" << std::endl;
-	      float xpos;  // in cm
-	      if (module1<module2) xpos=((int(module1/2)-20)*16+strip1+0.5)*stripwidth-358.4;
-	      else xpos=((int(module2/2)-20)*16+strip2+0.5)*stripwidth-358.4;
-	      float dtime;  // in us
-	      if (xpos>0) dtime = ctime1+((200.0-xpos)/driftvel);
-	      else dtime = ctime1+((200.0+xpos)/driftvel);
-	      if (dtime<rwcutlow || dtime>rwcuthigh ) match=false;
-	      // std::cout << "Event " << event << " " << module1 << " " << xpos << " " <<  ctime1 << " " << dtime << std::endl;
-	    }
-	  }	  
-	  if (match) {
-	   // std::cout << "Found One! Event " << event << 
-	   //     "   m/s1 m/s2 " << module1 << " " << strip1 << " " << 
-	   //     module2 << " " << strip2 << " " << ctime1 << " " <<ctime2 << std::endl;
-	    KeepMe=true;
-	  }
-	  }} // end loop over second strip
-	}} // end loop over first strip
+    // Sweep the strips in time so only pairs near in time are looked at. The window is
+    // one us wider than the coincidence as the check below may use the integer abs()
+    std::stable_sort(fStrips.begin(), fStrips.end(),
+                     [](const StripPair& a, const StripPair& b){ return a.ctime < b.ctime; });
+    for (size_t i = 0; i<fStrips.size() && !KeepMe; ++i){
+      for (size_t j = i+1; j<fStrips.size() && !KeepMe; ++j){
+	if (fStrips[j].ctime-fStrips[i].ctime > fTimeCoinc+1) break;
+	// pairs are checked in strip list order as the drift window cut is not symmetric
+	const StripPair& s1 = fStrips[i].index < fStrips[j].index ? fStrips[i] : fStrips[j];
+	const StripPair& s2 = fStrips[i].index < fStrips[j].index ? fStrips[j] : fStrips[i];
+	float diff = abs(s1.ctime-s2.ctime);
+	if (diff<=fTimeCoinc && MatchStrips(s1, s2)) {
+	  // std::cout << "Found One! Event " << event << 
+	  //     "   m/s1 m/s2 " << s1.module << " " << s1.strip << " " << 
+	  //     s2.module << " " << s2.strip << " " << s1.ctime << " " << s2.ctime << std::endl;
+	  KeepMe=true;
+	}
+      }
+    }
     if (trigKeep) trig->Fill(1.0); else trig->Fill(0.0);
     return KeepMe;
 
@@ -31,6 +31,7 @@
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/GeometryCore.h"
 #include "larcorealg/Geometry/WireGeo.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/PtrVector.h"
 #include "canvas/Persistency/Common/Assns.h"
@@ -47,6 +48,9 @@
 #include <memory>
 #include <string>
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
 
 class FlashPredict;
 class FlashPredict : public art::EDProducer {
@@ -79,15 +83,23 @@ private:
   double fPEscale;
   double fChargeToNPhotonsShower, fChargeToNPhotonsTrack;
   std::string fDetector; // SBND or ICARUS
+  enum DetectorType { kSBND, kICARUS };
+  DetectorType fDetectorType;
   int fCryostat;  // =0 or =1 to match ICARUS reco chain selection
   bool fNoAvailableMetrics, fMakeTree, fSelectNeutrino, fUseUncoatedPMT, fUseCalo;
+  bool fMakeOpHitTimeHistos;
+  unsigned fMaxFlashCandidates; // flashes in the beam window each PFP is matched against
+  double fDriftDistanceTolerance; // slack on the drift volume when pruning flash candidates
+  double fDriftVelocity;
+  int fOpHitTimeBins; // 2 ns bins in the beam window used to find the flash time
   double fTermThreshold;
   std::vector<double> fPMTChannelCorrection;
   // geometry service
   static const size_t nMaxTPCs = 2; // ICARUS has 4 TPCs, however they need to be run independently
   std::array<flashana::QCluster_t, nMaxTPCs> qClusterInTPC;
 
-  void computeFlashMetrics(size_t idtpc, std::vector<recob::OpHit> const& OpHitSubset);
+  void computeFlashMetrics(size_t idtpc, std::vector<recob::OpHit> const& OpHitSubset,
+                           size_t begin, size_t end);
   ::flashana::Flash_t GetFlashPESpectrum(const recob::OpFlash& opflash);
   void CollectDownstreamPFParticles(const lar_pandora::PFParticleMap &pfParticleMap,
                                     const art::Ptr<recob::PFParticle> &particle,
@@ -98,18 +110,51 @@ private:
   void AddDaughters(const art::Ptr<recob::PFParticle>& pfp_ptr,
                     const art::ValidHandle<std::vector<recob::PFParticle> >& pfp_h,
                     std::vector<art::Ptr<recob::PFParticle> > &pfp_v);
-  bool isPDInCryoTPC(double pd_x, int icryo, size_t itpc, std::string detector);
-  bool isPDInCryoTPC(int pdChannel, int icryo, size_t itpc, std::string detector);
-  bool isChargeInCryoTPC(double qp_x, int icryo, int itpc, std::string detector);
+  bool isPDInCryoTPC(double pd_x, int icryo, size_t itpc, DetectorType detector) const;
+  bool isChargeInCryoTPC(double qp_x, int icryo, int itpc, DetectorType detector) const;
+  void fillOpDetInfo();
+  int opHitTimeBin(double time) const;
 
   int icountPE = 0;
   const art::ServiceHandle<geo::Geometry> geometry;
   opdet::sbndPDMapAlg pdMap; // SBND opdets map
 
+  // Per OpChannel geometry and type, filled once for the job
+  struct OpDetInfo {
+    double x, y, z;
+    int tpc;        // TPC of fCryostat whose light it sees, -1 if none
+    bool inCryo;    // inside fCryostat
+    bool coated;    // PMT used for the flash: coated PMTs for SBND, all PMTs for ICARUS
+    bool uncoated;  // SBND uncoated PMT
+    bool valid;     // OpChannel exists, the others are never in a cryostat or TPC nor coated
+  };
+  std::vector<OpDetInfo> fOpDetInfo;
+
+  // Light metrics of a flash in one TPC
+  struct FlashMetrics {
+    double x, y, z, r, pe, unpe;
+    int countPE;
+  };
+  // Flash candidate with its OpHits in [begin, end) of the time sorted subset
+  struct FlashCandidate {
+    double time;
+    size_t begin, end;
+    std::array<bool, nMaxTPCs> lightInTPC;
+    std::array<FlashMetrics, nMaxTPCs> metrics;
+  };
+  std::vector<FlashCandidate> _flash_candidates;
+  // Charge centroid of a PFP in one TPC and the flash times it allows
+  struct ChargeMetrics {
+    bool valid;
+    double x, y, z, q;
+    double minTime, maxTime;
+  };
+
   // root stuff
   TTree* _flashmatch_nuslice_tree;
-  TH1D *ophittime;
-  TH1D *ophittime2;
+  TH1D *ophittime = nullptr;
+  TH1D *ophittime2 = nullptr;
+  std::vector<std::pair<int, double>> _ophit_time_bins; // (time bin, PE) of the OpHits used for the flash time
 
   // Tree variables
   std::vector<double> _pe_reco_v, _pe_hypo_v;
@@ -39,23 +39,39 @@ FlashPredict::FlashPredict(fhicl::ParameterSet const& p)
   fCryostat                 = p.get<int>("Cryostat", 0); //set =0 ot =1 for ICARUS to match reco chain selection
   fPEscale                  = p.get<double>("PEscale", 1.0);
   fTermThreshold            = p.get<double>("ThresholdTerm", 30.);
+  fMakeOpHitTimeHistos      = p.get<bool>("MakeOpHitTimeHistos", false);
+  fMaxFlashCandidates       = p.get<unsigned>("MaxFlashCandidates", 1);
+  fDriftDistanceTolerance   = p.get<double>("DriftDistanceTolerance", 10.);  // in cm
 
-  if (fDetector == "SBND" && fCryostat == 1) {
+  if (fDetector == "SBND") fDetectorType = kSBND;
+  else if (fDetector == "ICARUS") fDetectorType = kICARUS;
+  else {
+    throw cet::exception("FlashPredict") << "Unknown Detector " << fDetector << ". \n"
+                                         << "Check Detector parameter." << std::endl;
+  }
+
+  if (fDetectorType == kSBND && fCryostat == 1) {
     throw cet::exception("FlashPredictSBND") << "SBND has only one cryostat. \n"
                                              << "Check Detector and Cryostat parameter." << std::endl;
   }
-  else if (fDetector == "ICARUS" && fCryostat > 1) {
+  else if (fDetectorType == kICARUS && fCryostat > 1) {
     throw cet::exception("FlashPredictICARUS") << "ICARUS has only two cryostats. \n"
                                                << "Check Detector and Cryostat parameter." << std::endl;
   }
 
+  fillOpDetInfo();
+  fDriftVelocity = lar::providerFrom<detinfo::DetectorPropertiesService>()->DriftVelocity(); // in cm/us
+
   art::ServiceHandle<art::TFileService> tfs;
 
-  int time_bins = 500 * (fBeamWindowEnd - fBeamWindowStart);
-  ophittime = tfs->make<TH1D>("ophittime", "ophittime", time_bins, fBeamWindowStart, fBeamWindowEnd); // in us
-  ophittime->SetOption("HIST");
-  ophittime2 = tfs->make<TH1D>("ophittime2", "ophittime2", 5 * time_bins, -5.0, +10.0); // in us
-  ophittime2->SetOption("HIST");
+  fOpHitTimeBins = 500 * (fBeamWindowEnd - fBeamWindowStart);
+  // The flash time no longer needs these, they are only kept for diagnostics
+  if (fMakeOpHitTimeHistos) {
+    ophittime = tfs->make<TH1D>("ophittime", "ophittime", fOpHitTimeBins, fBeamWindowStart, fBeamWindowEnd); // in us
+    ophittime->SetOption("HIST");
+    ophittime2 = tfs->make<TH1D>("ophittime2", "ophittime2", 5 * fOpHitTimeBins, -5.0, +10.0); // in us
+    ophittime2->SetOption("HIST");
+  }
 
   if (fMakeTree) {
     _flashmatch_nuslice_tree = tfs->make<TTree>("nuslicetree", "nu FlashPredict tree");
@@ -160,7 +176,7 @@ FlashPredict::FlashPredict(fhicl::ParameterSet const& p)
     }
   }
   //
-  if (fDetector == "SBND" ) {
+  if (fDetectorType == kSBND) {
     temphisto = (TH1*)infile->Get("pe_h1");
     n_bins = temphisto->GetNbinsX();
     if (n_bins <= 0 || fNoAvailableMetrics) {
@@ -184,7 +200,7 @@ FlashPredict::FlashPredict(fhicl::ParameterSet const& p)
       }
     }
   }
-  else if (fDetector == "ICARUS" ) {
+  else if (fDetectorType == kICARUS) {
     n_bins = 1;
     pe_means.push_back(0);
     pe_spreads.push_back(0.001);
@@ -218,7 +234,6 @@ void FlashPredict::produce(art::Event & e)
     mf::LogWarning("FlashPredict") << "nTPC can't be larger than 2, resizing.";
     nTPCs = 2;
   }
-  geo::CryostatGeo geo_cryo = geometry->Cryostat(fCryostat);
 
   // grab PFParticles in event
   auto const& pfp_h = e.getValidHandle<std::vector<recob::PFParticle> >(fPandoraProducer);
@@ -264,47 +279,116 @@ void FlashPredict::produce(art::Event & e)
   for (unsigned int p=0; p<pfp_h->size(); p++) _pfpmap[pfp_h->at(p).Self()] = p;
 
   // get flash time
-  ophittime->Reset();
-  ophittime2->Reset();
+  // Only the bins with OpHits are kept, this gives the same maximum bin as
+  // filling a 2 ns histogram over the whole beam window
+  if (fMakeOpHitTimeHistos) {
+    ophittime->Reset();
+    ophittime2->Reset();
+  }
+  _ophit_time_bins.clear();
   for(auto const& oph : OpHitSubset) {
-    double PMTxyz[3];
-    geometry->OpDetGeoFromOpChannel(oph.OpChannel()).GetCenter(PMTxyz);
-    if (fDetector == "SBND" && pdMap.isPDType(oph.OpChannel(), "pmt_uncoated"))
+    const OpDetInfo& opdet = fOpDetInfo.at(oph.OpChannel());
+    if (!opdet.valid) continue;
+    if (fMakeOpHitTimeHistos && opdet.uncoated)
       ophittime2->Fill(oph.PeakTime(), fPEscale * oph.PE());
-    if (fDetector == "SBND" && !pdMap.isPDType(oph.OpChannel(), "pmt_coated")) continue; // use only coated PMTs for SBND for flash_time
-    if (!geo_cryo.ContainsPosition(PMTxyz)) continue;   // use only PMTs in the specified cryostat for ICARUS
+    if (!opdet.coated) continue; // use only coated PMTs for SBND for flash_time
+    if (!opdet.inCryo) continue;   // use only PMTs in the specified cryostat for ICARUS
     //    std::cout << "op hit " << j << " channel " << oph.OpChannel() << " time " << oph.PeakTime() << " pe " << fPEscale*oph.PE() << std::endl;
 
-    ophittime->Fill(oph.PeakTime(), fPEscale * oph.PE());
+    if (fMakeOpHitTimeHistos) ophittime->Fill(oph.PeakTime(), fPEscale * oph.PE());
+    _ophit_time_bins.emplace_back(opHitTimeBin(oph.PeakTime()), fPEscale * oph.PE());
     // double thisPE = fPEscale*oph.PE();
     // if (thisPE>1) ophittime->Fill(oph.PeakTime(),thisPE);
   }
 
-  if (ophittime->GetEntries() <= 0 || ophittime->Integral() < fMinFlashPE) {
+  // stable sort keeps the filling order within a bin, so the sums match the histogram ones
+  std::stable_sort(_ophit_time_bins.begin(), _ophit_time_bins.end(),
+                   [](const std::pair<int, double>& a, const std::pair<int, double>& b)-> bool
+                     { return a.first < b.first; });
+  // sum up each 2 ns bin, the bins come out in time order
+  std::vector<std::pair<int, double>> binPEs;
+  double integral = 0.;
+  for (size_t i=0; i<_ophit_time_bins.size(); ) {
+    int bin = _ophit_time_bins[i].first;
+    double binPE = 0.;
+    for (; i<_ophit_time_bins.size() && _ophit_time_bins[i].first == bin; ++i)
+      binPE += _ophit_time_bins[i].second;
+    integral += binPE;
+    binPEs.emplace_back(bin, binPE);
+  }
+
+  if (_ophit_time_bins.empty() || integral < fMinFlashPE) {
     e.put(std::move(T0_v));
     e.put(std::move(pfp_t0_assn_v));
     return;
   }
 
-  auto ibin =  ophittime->GetMaximumBin();
-  _flash_time = (ibin * 0.002) + fBeamWindowStart; // in us
-  double lowedge = _flash_time + fLightWindowStart;
-  double highedge = _flash_time + fLightWindowEnd;
-  mf::LogDebug("FlashPredict") << "light window " << lowedge << " " << highedge << std::endl;
-
-  // only use optical hits around the flash time
-  OpHitSubset.erase(std::remove_if(OpHitSubset.begin(), OpHitSubset.end(),
-                                   [lowedge, highedge](const recob::OpHit& oph)-> bool
-                                     { return ((oph.PeakTime() < lowedge) || (oph.PeakTime() > highedge)); }),
-                    OpHitSubset.end());
-
-  // check if the TPC has OpHits
-  bool lightInTPC[nMaxTPCs] = {false};
-  for (size_t t=0; t<nMaxTPCs; t++){
-    auto it = std::find_if (OpHitSubset.begin(), OpHitSubset.end(),
-                            [t, this](const recob::OpHit& oph)-> bool
-                              { return isPDInCryoTPC(oph.OpChannel(), fCryostat, t, fDetector); });
-    lightInTPC[t] = (it != OpHitSubset.end());
+  // Flash candidates are taken from the highest bin down, the stable sort
+  // makes the first bin win on ties, as in TH1::GetMaximumBin
+  std::vector<size_t> binOrder(binPEs.size());
+  std::iota(binOrder.begin(), binOrder.end(), 0);
+  std::stable_sort(binOrder.begin(), binOrder.end(),
+                   [&binPEs](size_t a, size_t b)-> bool
+                     { return binPEs[a].second > binPEs[b].second; });
+
+  // with the OpHits in time order the light window of a flash is just a range
+  std::stable_sort(OpHitSubset.begin(), OpHitSubset.end(),
+                   [](const recob::OpHit& a, const recob::OpHit& b)-> bool
+                     { return a.PeakTime() < b.PeakTime(); });
+
+  _flash_candidates.clear();
+  for (size_t ib : binOrder) {
+    if (_flash_candidates.size() >= fMaxFlashCandidates) break;
+    double flash_time = (binPEs[ib].first * 0.002) + fBeamWindowStart; // in us
+    double lowedge = flash_time + fLightWindowStart;
+    double highedge = flash_time + fLightWindowEnd;
+
+    // each OpHit only belongs to one candidate
+    bool overlaps = false;
+    for (auto const& flash : _flash_candidates) {
+      if (lowedge <= flash.time + fLightWindowEnd && flash.time + fLightWindowStart <= highedge) {
+        overlaps = true;
+        break;
+      }
+    }
+    if (overlaps) continue;
+
+    FlashCandidate flash;
+    flash.time = flash_time;
+    // only use optical hits around the flash time
+    flash.begin = std::lower_bound(OpHitSubset.begin(), OpHitSubset.end(), lowedge,
+                                   [](const recob::OpHit& oph, double t)-> bool
+                                     { return oph.PeakTime() < t; }) - OpHitSubset.begin();
+    flash.end = std::upper_bound(OpHitSubset.begin(), OpHitSubset.end(), highedge,
+                                 [](double t, const recob::OpHit& oph)-> bool
+                                   { return t < oph.PeakTime(); }) - OpHitSubset.begin();
+
+    // the first candidate passed the beam window PE cut above, the others need it in their own window
+    if (!_flash_candidates.empty()) {
+      double windowPE = 0.;
+      for (size_t i=flash.begin; i<flash.end; ++i) {
+        const OpDetInfo& opdet = fOpDetInfo.at(OpHitSubset[i].OpChannel());
+        if (opdet.coated && opdet.inCryo) windowPE += fPEscale * OpHitSubset[i].PE();
+      }
+      if (windowPE < fMinFlashPE) continue;
+    }
+    mf::LogDebug("FlashPredict") << "light window " << lowedge << " " << highedge << std::endl;
+
+    // check if the TPC has OpHits, the light metrics don't depend on the PFP
+    // so they are worked out once here
+    for (size_t t=0; t<nMaxTPCs; t++){
+      flash.lightInTPC[t] = false;
+      for (size_t i=flash.begin; i<flash.end; ++i) {
+        if (fOpDetInfo.at(OpHitSubset[i].OpChannel()).tpc == int(t)) {
+          flash.lightInTPC[t] = true;
+          break;
+        }
+      }
+      if (!flash.lightInTPC[t] || t >= nTPCs) continue;
+      computeFlashMetrics(t, OpHitSubset, flash.begin, flash.end);
+      flash.metrics[t] = {_flash_x, _flash_y, _flash_z, _flash_r, _flash_pe, _flash_unpe, icountPE};
+    }
+    _flash_candidates.push_back(flash);
   }
 
   // Loop over pandora pfp particles
@@ -380,7 +464,7 @@ void FlashPredict::produce(art::Event & e)
           const auto &position(SP->XYZ());
           const auto tpcindex = wid.TPC;
           // throw the charge coming from another TPC
-          if (!isChargeInCryoTPC(position[0], fCryostat, tpcindex, fDetector)) continue;
+          if (!isChargeInCryoTPC(position[0], fCryostat, tpcindex, fDetectorType)) continue;
           const auto charge(hit->Integral());
           double Wxyz[3];
           geometry->WireIDToWireGeo(wid).GetCenter(Wxyz);
@@ -394,104 +478,153 @@ void FlashPredict::produce(art::Event & e)
       //      }  // if track or shower
     } // for all pfp pointers
 
-    double mscore[nMaxTPCs] = {0.};
-    // double charge[nMaxTPCs] = {0.}; // TODO: Use this
+    // charge centroid of the PFP in each TPC and the flash times its drift allows
+    std::array<ChargeMetrics, nMaxTPCs> chargeInTPC;
     for (size_t itpc=0; itpc<nTPCs; ++itpc) {
-      if (!lightInTPC[itpc]) continue;
+      ChargeMetrics& charge = chargeInTPC[itpc];
       double xave = 0.0; double yave = 0.0; double zave = 0.0; double norm = 0.0;
-      _charge_q = 0;
-      // TODO: use accumulators instead of this for loop
-      for (size_t i=0; i<qClusterInTPC[itpc].size(); ++i) {
-        flashana::QCluster_t this_cl = qClusterInTPC[itpc];
-        flashana::QPoint_t qp = this_cl[i];
+      double xmin = std::numeric_limits<double>::max();
+      double xmax = std::numeric_limits<double>::lowest();
+      charge.q = 0;
+      for (auto const& qp : qClusterInTPC[itpc]) {
         xave += 0.001 * qp.q * qp.x;
         yave += 0.001 * qp.q * qp.y;
         zave += 0.001 * qp.q * qp.z;
         norm += 0.001 * qp.q;
-        _charge_q += qp.q;
+        charge.q += qp.q;
+        xmin = std::min(xmin, qp.x);
+        xmax = std::max(xmax, qp.x);
       }
-      if (norm <= 0) {
+      charge.valid = (norm > 0);
+      if (!charge.valid) {
         // mf::LogWarning("FlashPredict") << "No charge in the TPC, continue.";
         continue;
       }
-      _charge_x = xave / norm;
-      _charge_y = yave / norm;
-      _charge_z = zave / norm;
-      // charge[itpc] = _charge_q; //TODO: Use this
-
-      computeFlashMetrics(itpc, OpHitSubset);
-
-      // calculate match score here, put association on the event
-      double slice = _charge_x;
-      _score = 0.; int icount = 0;
-      double term;
-      std::ostringstream thresholdMessage;
-      thresholdMessage << std::left << std::setw(12) << std::setfill(' ');
-      thresholdMessage << "pfp.PdgCode:\t" << pfp.PdgCode() << "\n"
-                       << "_run:       \t" << _run << "\n"
-                       << "_sub:       \t" << _sub << "\n"
-                       << "_evt:       \t" << _evt << "\n"
-                       << "itpc:       \t" << itpc << "\n"
-                       << "_flash_y:   \t" << std::setw(8) << _flash_y   << ",\t"
-                       << "_charge_y:  \t" << std::setw(8) << _charge_y  << "\n"
-                       << "_flash_z:   \t" << std::setw(8) << _flash_z   << ",\t"
-                       << "_charge_z:  \t" << std::setw(8) << _charge_z  << "\n"
-                       << "_flash_x:   \t" << std::setw(8) << _flash_x   << ",\t"
-                       << "_charge_x:  \t" << std::setw(8) << _charge_x  << "\n"
-                       << "_flash_pe:  \t" << std::setw(8) << _flash_pe  << ",\t"
-                       << "_charge_q:  \t" << std::setw(8) << _charge_q  << "\n"
-                       << "_flash_r:   \t" << std::setw(8) << _flash_r   << "\n"
-                       << "_flash_time: \t" << std::setw(8) << _flash_time << "\n" << std::endl;
-      int isl = int(n_bins * (slice / fDriftDistance));
-      if (dy_spreads[isl] > 0) {
-        term = std::abs(std::abs(_flash_y - _charge_y) - dy_means[isl]) / dy_spreads[isl];
-        if (term > fTermThreshold) std::cout << "\nBig term Y:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage.str();
-        _score += term;
-      }
-      icount++;
-      isl = int(n_bins * (slice / fDriftDistance));
-      if (dz_spreads[isl] > 0) {
-        term = std::abs(std::abs(_flash_z - _charge_z) - dz_means[isl]) / dz_spreads[isl];
-        if (term > fTermThreshold) std::cout << "\nBig term Z:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage.str();
-        _score += term;
-      }
-      icount++;
-      isl = int(n_bins * (slice / fDriftDistance));
-      if (rr_spreads[isl] > 0 && _flash_r > 0) {
-        term = std::abs(_flash_r - rr_means[isl]) / rr_spreads[isl];
-        if (term > fTermThreshold) std::cout << "\nBig term R:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage.str();
-        _score += term;
-      }
-      icount++;
-      if (fDetector == "SBND" && fUseUncoatedPMT) {
+      charge.x = xave / norm;
+      charge.y = yave / norm;
+      charge.z = zave / norm;
+      // xpos assumes the charge arrived at the trigger time, a flash at time t
+      // shifts all of it by the drift in t and it must stay inside the drift volume
+      charge.minTime = (xmax - fDriftDistance - fDriftDistanceTolerance) / fDriftVelocity;
+      charge.maxTime = (xmin + fDriftDistanceTolerance) / fDriftVelocity;
+    }
+
+    // score the PFP against every flash candidate and keep the best match
+    int bestFlash = -1;
+    double bestScore = 0.;
+    int bestCountPE = 0;
+    for (size_t ic=0; ic<_flash_candidates.size(); ++ic) {
+      const FlashCandidate& flash = _flash_candidates[ic];
+      _flash_time = flash.time;
+
+      double mscore[nMaxTPCs] = {0.};
+      // double charge[nMaxTPCs] = {0.}; // TODO: Use this
+      for (size_t itpc=0; itpc<nTPCs; ++itpc) {
+        if (!flash.lightInTPC[itpc]) continue;
+        const ChargeMetrics& charge = chargeInTPC[itpc];
+        if (!charge.valid) continue;
+        // this flash can't have come from this charge, only used to choose
+        // between candidates so a single flash is matched as it always was
+        if (_flash_candidates.size() > 1 &&
+            (flash.time < charge.minTime || flash.time > charge.maxTime)) continue;
+        _charge_x = charge.x;
+        _charge_y = charge.y;
+        _charge_z = charge.z;
+        _charge_q = charge.q;
+        // charge[itpc] = _charge_q; //TODO: Use this
+
+        const FlashMetrics& metrics = flash.metrics[itpc];
+        _flash_x    = metrics.x;
+        _flash_y    = metrics.y;
+        _flash_z    = metrics.z;
+        _flash_r    = metrics.r;
+        _flash_pe   = metrics.pe;
+        _flash_unpe = metrics.unpe;
+        if (_flash_pe > 0) icountPE = metrics.countPE;
+
+        // calculate match score here, put association on the event
+        double slice = _charge_x;
+        _score = 0.; int icount = 0;
+        double term;
+        // only formatted when a term is over threshold
+        auto thresholdMessage = [&]()-> std::string {
+          std::ostringstream thresholdMessage;
+          thresholdMessage << std::left << std::setw(12) << std::setfill(' ');
+          thresholdMessage << "pfp.PdgCode:\t" << pfp.PdgCode() << "\n"
+                           << "_run:       \t" << _run << "\n"
+                           << "_sub:       \t" << _sub << "\n"
+                           << "_evt:       \t" << _evt << "\n"
+                           << "itpc:       \t" << itpc << "\n"
+                           << "_flash_y:   \t" << std::setw(8) << _flash_y   << ",\t"
+                           << "_charge_y:  \t" << std::setw(8) << _charge_y  << "\n"
+                           << "_flash_z:   \t" << std::setw(8) << _flash_z   << ",\t"
+                           << "_charge_z:  \t" << std::setw(8) << _charge_z  << "\n"
+                           << "_flash_x:   \t" << std::setw(8) << _flash_x   << ",\t"
+                           << "_charge_x:  \t" << std::setw(8) << _charge_x  << "\n"
+                           << "_flash_pe:  \t" << std::setw(8) << _flash_pe  << ",\t"
+                           << "_charge_q:  \t" << std::setw(8) << _charge_q  << "\n"
+                           << "_flash_r:   \t" << std::setw(8) << _flash_r   << "\n"
+                           << "_flash_time: \t" << std::setw(8) << _flash_time << "\n" << std::endl;
+          return thresholdMessage.str();
+        };
+        int isl = int(n_bins * (slice / fDriftDistance));
+        if (dy_spreads[isl] > 0) {
+          term = std::abs(std::abs(_flash_y - _charge_y) - dy_means[isl]) / dy_spreads[isl];
+          if (term > fTermThreshold) std::cout << "\nBig term Y:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage();
+          _score += term;
+        }
+        icount++;
         isl = int(n_bins * (slice / fDriftDistance));
-        double myratio = 100.0 * _flash_unpe;
-        if (pe_spreads[isl] > 0 && _flash_pe > 0) {
-          myratio /= _flash_pe;
-          term = std::abs(myratio - pe_means[isl]) / pe_spreads[isl];
-          if (term > fTermThreshold) std::cout << "\nBig term RATIO:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage.str();
+        if (dz_spreads[isl] > 0) {
+          term = std::abs(std::abs(_flash_z - _charge_z) - dz_means[isl]) / dz_spreads[isl];
+          if (term > fTermThreshold) std::cout << "\nBig term Z:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage();
           _score += term;
-          icount++;
         }
+        icount++;
+        isl = int(n_bins * (slice / fDriftDistance));
+        if (rr_spreads[isl] > 0 && _flash_r > 0) {
+          term = std::abs(_flash_r - rr_means[isl]) / rr_spreads[isl];
+          if (term > fTermThreshold) std::cout << "\nBig term R:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage();
+          _score += term;
+        }
+        icount++;
+        if (fDetectorType == kSBND && fUseUncoatedPMT) {
+          isl = int(n_bins * (slice / fDriftDistance));
+          double myratio = 100.0 * _flash_unpe;
+          if (pe_spreads[isl] > 0 && _flash_pe > 0) {
+            myratio /= _flash_pe;
+            term = std::abs(myratio - pe_means[isl]) / pe_spreads[isl];
+            if (term > fTermThreshold) std::cout << "\nBig term RATIO:\t" << term << ",\tisl:\t" << isl << "\n" << thresholdMessage();
+            _score += term;
+            icount++;
+          }
+        }
+        //      _score/=icount;
+        if (_flash_pe > 0 ) { // TODO: is this really the best condition?
+          mscore[itpc] = _score;
+          if (fMakeTree) _flashmatch_nuslice_tree->Fill();
+        }
+      }  // end loop over TPCs
+
+      double this_score = 0.0; int icount = 0; // double totc = 0; //TODO: Use this
+      for (size_t itpc=0; itpc<nTPCs; ++itpc) {
+        this_score += mscore[itpc];
+        // totc += charge[itpc];
+        if (mscore[itpc] > 0) icount++;
       }
-      //      _score/=icount;
-      if (_flash_pe > 0 ) { // TODO: is this really the best condition?
-        mscore[itpc] = _score;
-        if (fMakeTree) _flashmatch_nuslice_tree->Fill();
+      if (icount > 0) {
+        this_score /= (icount * 1.0);
+        if (bestFlash < 0 || this_score < bestScore) {
+          bestFlash = ic;
+          bestScore = this_score;
+          bestCountPE = icountPE;
+        }
       }
-    }  // end loop over TPCs
-
-    double this_score = 0.0; int icount = 0; // double totc = 0; //TODO: Use this
-    for (size_t itpc=0; itpc<nTPCs; ++itpc) {
-      this_score += mscore[itpc];
-      // totc += charge[itpc];
-      if (mscore[itpc] > 0) icount++;
-    }
-    if (icount > 0) {
-      this_score /= (icount * 1.0);
+    } // over all flash candidates
 
+    if (bestFlash >= 0) {
       // create t0 and pfp-t0 association here
-      T0_v->push_back(anab::T0(_flash_time, icountPE, p, 0, this_score));
+      T0_v->push_back(anab::T0(_flash_candidates[bestFlash].time, bestCountPE, p, 0, bestScore));
       //    util::CreateAssn(*this, e, *T0_v, pfp_h[p], *pfp_t0_assn_v);
       //    util::CreateAssn(*this, e, *T0_v, pfp, *pfp_t0_assn_v);
       util::CreateAssn(*this, e, *T0_v, pfp_ptr, *pfp_t0_assn_v);
@@ -503,7 +636,8 @@ void FlashPredict::produce(art::Event & e)
 
 }// end of producer module
 
-void FlashPredict::computeFlashMetrics(size_t itpc, std::vector<recob::OpHit> const& OpHitSubset)
+void FlashPredict::computeFlashMetrics(size_t itpc, std::vector<recob::OpHit> const& OpHitSubset,
+                                       size_t begin, size_t end)
 {
   // store PMT photon counts in the tree as well
   double PMTxyz[3];
@@ -517,14 +651,14 @@ void FlashPredict::computeFlashMetrics(size_t itpc, std::vector<recob::OpHit> co
   double sum_D =  0;
   // TODO: change this next loop, such that it only loops
   // through channels in the current fCryostat
-  for(auto const& oph : OpHitSubset) {
-    std::string op_type = "pmt"; // the label ICARUS has
-    if (fDetector == "SBND") op_type = pdMap.pdType(oph.OpChannel());
-    geometry->OpDetGeoFromOpChannel(oph.OpChannel()).GetCenter(PMTxyz);
+  for(size_t i=begin; i<end; ++i) {
+    auto const& oph = OpHitSubset[i];
+    const OpDetInfo& opdet = fOpDetInfo.at(oph.OpChannel());
     // check cryostat and tpc
-    if (!isPDInCryoTPC(PMTxyz[0], fCryostat, itpc, fDetector)) continue;
+    if (!opdet.valid || opdet.tpc != int(itpc)) continue;
+    PMTxyz[0] = opdet.x; PMTxyz[1] = opdet.y; PMTxyz[2] = opdet.z;
     // only use PMTs for SBND
-    if (op_type == "pmt_coated" || op_type == "pmt") {
+    if (opdet.coated) {
       // Add up the position, weighting with PEs
       _flash_x = PMTxyz[0];
       sum     += 1.0;
@@ -539,19 +673,10 @@ void FlashPredict::computeFlashMetrics(size_t itpc, std::vector<recob::OpHit> co
       sum_Cy  += oph.PE() * oph.PE() * PMTxyz[1];
       sum_Cz  += oph.PE() * oph.PE() * PMTxyz[2];
     }
-    else if ( op_type == "pmt_uncoated") {
+    else if (opdet.uncoated) {
       unpe_tot += oph.PE();
     }
-    else if ( (op_type == "arapuca_vuv" || op_type == "arapuca_vis") ) {
-      //TODO: Use ARAPUCA
-      // arape_tot+=oph.PE();
-      continue;
-    }
-    else if ( op_type == "xarapuca_vuv" || op_type == "xarapuca_vis")  {
-      //TODO: Use XARAPUCA
-      // xarape_tot+=oph.PE();
-      continue;
-    }
+    //TODO: Use ARAPUCA and XARAPUCA
   }
 
   if (pnorm > 0) {
@@ -571,7 +696,7 @@ void FlashPredict::computeFlashMetrics(size_t itpc, std::vector<recob::OpHit> co
   else {
     mf::LogWarning("FlashPredict") << "Really odd that I landed here, this shouldn't had happen.\n"
                                    << "pnorm:\t" << pnorm << "\n"
-                                   << "OpHitSubset.size():\t" << OpHitSubset.size() << "\n";
+                                   << "OpHits in flash:\t" << (end - begin) << "\n";
     _flash_y = 0;
     _flash_z = 0;
     _flash_r = 0;
@@ -687,30 +812,21 @@ void FlashPredict::AddDaughters(
 
 // TODO: no hardcoding
 // TODO: collapse with the next
-bool FlashPredict::isPDInCryoTPC(double pd_x, int icryo, size_t itpc, std::string detector)
+bool FlashPredict::isPDInCryoTPC(double pd_x, int icryo, size_t itpc, DetectorType detector) const
 {
   // check whether this optical detector views the light inside this tpc.
-  std::ostringstream lostPDMessage;
-  lostPDMessage << "\nThere's an " << detector << "photo detector that belongs nowhere. \n"
-                << "icryo: " << icryo << "\n"
-                << "itpc:  " << itpc <<  "\n"
-                << "pd_x:  " << pd_x <<  std::endl;
-
-  if (detector == "ICARUS") {
+  if (detector == kICARUS) {
     if (icryo == 0) {
       if (itpc == 0 && -400 < pd_x && pd_x < -300 ) return true;
       else if (itpc == 1 && -100 < pd_x && pd_x < 0) return true;
-      // else {std::cout << lostPDMessage.str(); return false;}
     }
     else if (icryo == 1) {
       if (itpc == 0 && 0 < pd_x && pd_x < 100) return true;
       else if (itpc == 1 && 300 < pd_x && pd_x < 400) return true;
-      // else {std::cout << lostPDMessage.str(); return false;}
     }
   }
-  else if (detector == "SBND") {
+  else if (detector == kSBND) {
     if ((itpc == 0 && -213. < pd_x && pd_x < 0) || (itpc == 1 && 0 < pd_x && pd_x < 213) ) return true;
-    //    else {std::cout << lostPDMessage.str(); return false;}
     else {
       return false;
     }
@@ -718,48 +834,74 @@ bool FlashPredict::isPDInCryoTPC(double pd_x, int icryo, size_t itpc, std::strin
   return false;
 }
 
-bool FlashPredict::isPDInCryoTPC(int pdChannel, int icryo, size_t itpc, std::string detector)
+// Classify every OpChannel once, so the per OpHit loops only do a lookup
+void FlashPredict::fillOpDetInfo()
 {
-  // check whether this optical detector views the light inside this tpc.
-  double dummy[3];
-  geometry->OpDetGeoFromOpChannel(pdChannel).GetCenter(dummy);
-  double pd_x = dummy[0];
-  return isPDInCryoTPC(pd_x, icryo, itpc, detector);
+  geo::CryostatGeo const& geo_cryo = geometry->Cryostat(fCryostat);
+  // MaxOpChannel() is the number of channels, not the last one, so entries
+  // that are not a valid channel are kept flagged and never used
+  fOpDetInfo.assign(geometry->MaxOpChannel() + 1,
+                    OpDetInfo{0., 0., 0., -1, false, false, false, false});
+  for (size_t ch=0; ch<fOpDetInfo.size(); ++ch) {
+    if (!geometry->IsValidOpChannel(ch)) continue;
+    OpDetInfo& opdet = fOpDetInfo[ch];
+    opdet.valid = true;
+    double PMTxyz[3];
+    geometry->OpDetGeoFromOpChannel(ch).GetCenter(PMTxyz);
+    opdet.x = PMTxyz[0];
+    opdet.y = PMTxyz[1];
+    opdet.z = PMTxyz[2];
+    opdet.inCryo = geo_cryo.ContainsPosition(PMTxyz);
+    opdet.tpc = -1;
+    for (size_t t=0; t<nMaxTPCs; t++) {
+      if (isPDInCryoTPC(opdet.x, fCryostat, t, fDetectorType)) {
+        opdet.tpc = t;
+        break;
+      }
+    }
+    if (fDetectorType == kSBND) {
+      std::string op_type = pdMap.pdType(ch);
+      opdet.coated = (op_type == "pmt_coated");
+      opdet.uncoated = (op_type == "pmt_uncoated");
+    }
+    else {
+      // the label ICARUS has is "pmt"
+      opdet.coated = true;
+      opdet.uncoated = false;
+    }
+  }
 }
 
 // TODO: no hardcoding
 // TODO: collapse with the previous
 // TODO: figure out what to do with the charge that falls into the crevices
-bool FlashPredict::isChargeInCryoTPC(double qp_x, int icryo, int itpc, std::string detector)
+bool FlashPredict::isChargeInCryoTPC(double qp_x, int icryo, int itpc, DetectorType detector) const
 {
-  std::ostringstream lostChargeMessage;
-  lostChargeMessage << "\nThere's " << detector << " charge that belongs nowhere. \n"
-                    << "icryo: " << icryo << "\n"
-                    << "itpc: "  << itpc << "\n"
-                    << "qp_x: " << qp_x << std::endl;
-
-  if (detector == "ICARUS") {
+  if (detector == kICARUS) {
     if (icryo == 0) {
       if (itpc == 0 && -368.49 <= qp_x && qp_x <= -220.29 ) return true;
       else if (itpc == 1 && -220.14 <= qp_x && qp_x <= -71.94) return true;
-      // else {std::cout << lostChargeMessage.str(); return false;}
     }
     else if (icryo == 1) {
       if (itpc == 0 && 71.94 <= qp_x && qp_x <= 220.14) return true;
       else if (itpc == 1 && 220.29 <= qp_x && qp_x <= 368.49) return true;
-      // else {std::cout << lostChargeMessage.str(); return false;}
     }
   }
-  else if (detector == "SBND") {
+  else if (detector == kSBND) {
     if ((itpc == 0 && qp_x < 0) || (itpc == 1 && qp_x > 0) ) return true;
     else {
       return false;
     }
-    //    else {std::cout << lostChargeMessage.str(); return false;}
   }
   return false;
 }
 
+// Bin of the OpHit time, numbered as the ophittime histogram bins
+int FlashPredict::opHitTimeBin(double time) const
+{
+  return 1 + int(fOpHitTimeBins * (time - fBeamWindowStart) / (fBeamWindowEnd - fBeamWindowStart));
+}
+
 void FlashPredict::beginJob()
 {
   // Implementation of optional member function here.
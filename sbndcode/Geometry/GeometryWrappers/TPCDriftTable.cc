@@ -0,0 +1,22 @@
+#include "TPCDriftTable.h"
+
+#include <cstdlib>
+
+namespace sbnd {
+namespace TPCGeoUtil {
+// Cache the drift direction and limits of every TPC
+TPCDriftTable MakeTPCDriftTable(const geo::GeometryCore *GeometryService){
+  TPCDriftTable driftTable(GeometryService->Ncryostats());
+  for(size_t cryo_i = 0; cryo_i < GeometryService->Ncryostats(); cryo_i++){
+    const geo::CryostatGeo& cryostat = GeometryService->Cryostat(cryo_i);
+    for(size_t tpc_i = 0; tpc_i < cryostat.NTPC(); tpc_i++){
+      const geo::TPCGeo& tpcGeo = cryostat.TPC(tpc_i);
+      int driftDirection = tpcGeo.DetectDriftDirection();
+      if(std::abs(driftDirection) != 1) driftDirection = 0;
+      driftTable[cryo_i].push_back({driftDirection, tpcGeo.MinX(), tpcGeo.MaxX()});
+    }
+  }
+  return driftTable;
+}
+}
+}
@@ -0,0 +1,32 @@
+#ifndef TPCDRIFTTABLE_H_SEEN
+#define TPCDRIFTTABLE_H_SEEN
+
+
+///////////////////////////////////////////////
+// TPCDriftTable.h
+//
+// Drift direction and drift limits of every TPC,
+// shared by TPCGeoAlg and TPCGeoUtil
+///////////////////////////////////////////////
+
+// LArSoft
+#include "larcorealg/Geometry/GeometryCore.h"
+
+// c++
+#include <vector>
+
+namespace sbnd {
+namespace TPCGeoUtil {
+  // Drift direction and drift limits of a single TPC
+  struct TPCDriftInfo {
+    int driftDirection;
+    double minX;
+    double maxX;
+  };
+  // Drift info for every TPC indexed by [cryostat][tpc], build once and reuse for all hit queries
+  typedef std::vector<std::vector<TPCDriftInfo>> TPCDriftTable;
+  TPCDriftTable MakeTPCDriftTable(const geo::GeometryCore *GeometryService);
+}
+}
+
+#endif
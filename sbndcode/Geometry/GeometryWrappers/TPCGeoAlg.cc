@@ -15,12 +15,14 @@ TPCGeoAlg::TPCGeoAlg(){
 
   fGeometryService = lar::providerFrom<geo::Geometry>();
 
+  fTPCDriftTable = TPCGeoUtil::MakeTPCDriftTable(fGeometryService);
   for(size_t cryo_i = 0; cryo_i < fGeometryService->Ncryostats(); cryo_i++){
     const geo::CryostatGeo& cryostat = fGeometryService->Cryostat(cryo_i);
 
     for (size_t tpc_i = 0; tpc_i < cryostat.NTPC(); tpc_i++)
     {
       const geo::TPCGeo& tpcg = cryostat.TPC(tpc_i);
+
       if (tpcg.MinX() < fMinX) fMinX = tpcg.MinX();
       if (tpcg.MaxX() > fMaxX) fMaxX = tpcg.MaxX();
       if (tpcg.MinY() < fMinY) fMinY = tpcg.MinY();
@@ -97,7 +99,7 @@ bool TPCGeoAlg::InFiducial(geo::Point_t point, double minXCut, double minYCut, d
 
 // ----------------------------------------------------------------------------------
 // Determine which TPC a collection of hits is detected in (-1 if multiple) 
-int TPCGeoAlg::DetectedInTPC(std::vector<art::Ptr<recob::Hit>> hits){
+int TPCGeoAlg::DetectedInTPC(const std::vector<art::Ptr<recob::Hit>>& hits) const{
   // Return tpc of hit collection or -1 if in multiple
   if(hits.size() == 0) return -1;
   int tpc = hits[0]->WireID().TPC;
@@ -108,7 +110,7 @@ int TPCGeoAlg::DetectedInTPC(std::vector<art::Ptr<recob::Hit>> hits){
 }
 
 // Determine the drift direction for a collection of hits (-1, 0 or 1 assuming drift in X)
-int TPCGeoAlg::DriftDirectionFromHits(std::vector<art::Ptr<recob::Hit>> hits){
+int TPCGeoAlg::DriftDirectionFromHits(const std::vector<art::Ptr<recob::Hit>>& hits){
   // If there are no hits then return 0
   if(hits.size() == 0) return 0;
   
@@ -116,25 +118,22 @@ int TPCGeoAlg::DriftDirectionFromHits(std::vector<art::Ptr<recob::Hit>> hits){
   if(DetectedInTPC(hits) == -1) return 0;
 
   // Work out the drift direction
-  geo::TPCID tpcID = hits[0]->WireID().asTPCID();
-  const geo::TPCGeo& tpcGeo = fGeometryService->GetElement(tpcID);
-  double driftDirection = tpcGeo.DetectDriftDirection();
-  if(std::abs(driftDirection) != 1) driftDirection = 0;
-  return driftDirection;
+  const geo::WireID& wireID = hits[0]->WireID();
+  return fTPCDriftTable.at(wireID.Cryostat).at(wireID.TPC).driftDirection;
 }
 
 // Work out the drift limits for a collection of hits
-std::pair<double, double> TPCGeoAlg::XLimitsFromHits(std::vector<art::Ptr<recob::Hit>> hits){
+std::pair<double, double> TPCGeoAlg::XLimitsFromHits(const std::vector<art::Ptr<recob::Hit>>& hits){
   // If there are no hits then return 0
   if(hits.size() == 0) return std::make_pair(0, 0);
   
   // If the track is stitched (in multiple TPCs) return 0
   if(DetectedInTPC(hits) == -1) return std::make_pair(0, 0);
 
-  // Work out the drift direction
-  geo::TPCID tpcID = hits[0]->WireID().asTPCID();
-  const geo::TPCGeo& tpcGeo = fGeometryService->GetElement(tpcID);
-  return std::make_pair(tpcGeo.MinX(), tpcGeo.MaxX());
+  // Work out the drift limits
+  const geo::WireID& wireID = hits[0]->WireID();
+  const TPCGeoUtil::TPCDriftInfo& info = fTPCDriftTable.at(wireID.Cryostat).at(wireID.TPC);
+  return std::make_pair(info.minX, info.maxX);
 }
 
 // Is point inside given TPC
@@ -25,6 +25,9 @@
 #include "nusimdata/SimulationBase/MCParticle.h"
 #include "lardataobj/RecoBase/Hit.h"
 
+// sbndcode
+#include "sbndcode/Geometry/GeometryWrappers/TPCDriftTable.h"
+
 // c++
 #include <vector>
 
@@ -57,11 +60,11 @@ namespace sbnd{
     bool InsideTPC(geo::Point_t point, const geo::TPCGeo& tpc, double buffer=0.);
 
     // Determine which TPC a collection of hits is detected in (-1 if multiple)
-    int DetectedInTPC(std::vector<art::Ptr<recob::Hit>> hits);
+    int DetectedInTPC(const std::vector<art::Ptr<recob::Hit>>& hits) const;
     // Determine the drift direction for a collection of hits (-1, 0 or 1 assuming drift in X)
-    int DriftDirectionFromHits(std::vector<art::Ptr<recob::Hit>> hits);
+    int DriftDirectionFromHits(const std::vector<art::Ptr<recob::Hit>>& hits);
     // Work out the drift limits for a collection of hits
-    std::pair<double, double> XLimitsFromHits(std::vector<art::Ptr<recob::Hit>> hits);
+    std::pair<double, double> XLimitsFromHits(const std::vector<art::Ptr<recob::Hit>>& hits);
 
     double MinDistToWall(geo::Point_t point);
 
@@ -89,6 +92,9 @@ namespace sbnd{
     double fMaxZ;
     double fCpaWidth;
 
+    // Drift direction and limits of each TPC, indexed by [cryostat][tpc]
+    TPCGeoUtil::TPCDriftTable fTPCDriftTable;
+
     geo::GeometryCore const* fGeometryService;
 
   };
@@ -11,6 +11,11 @@
 #include <limits> // std::numeric_limits<>
 #include <getopt.h> // getopt_long(), option
 #include <stdexcept> // std::runtime_error
+#include <cstdlib> // strtod()
+#include <cstring> // strspn()
+#include <cmath>
+#include <cctype>
+#include <climits> // INT_MAX
 
 bool sci = false;
 bool setupChoice = false;
@@ -34,6 +39,16 @@ struct aSetup{
 
 typedef std::map<std::string, double> Variables_t;
 
+// A loop body line with the constant variables already replaced; the loop
+// variable is left as a slot so each iteration only has to join the pieces
+struct aLoopLine{
+	std::string original;
+	std::vector<std::string> segments;
+	bool usable;
+};
+
+const char loopSlot = char(1);
+
 bool isComment(TString key) {
 
 	int pos1 = key.Index("<!--");
@@ -52,37 +67,45 @@ bool isComment(TString key) {
 	return k;
 }
 
-void replaceVariable(TString &key, Variables_t const& variables ){
+TString variableText(double value){
 
-	Variables_t::const_iterator it;
 	std::stringstream stream;
 	TString varValue;
+	stream.precision(prec);
+	if(0) { stream << scientific << value;} else {stream << value;}
+	stream >> varValue;
+	return varValue;
+}
+
+void substituteVariable(TString &key, TString const& varName, TString const& varValue){
+
 	int i;
 	TString temp;
-	stream.precision(prec);
+	do {
+		i = key.Index(varName);
+		if (i>0) {
+			temp = key;
+			temp.Remove(i);
+			temp += varValue;
+			key.Replace(0,i+varName.Length(),"");
+			temp += key;
+			key = temp;
+		}
+	} while (i>0);
+}
+
+void replaceVariable(TString &key, Variables_t const& variables ){
+
+	Variables_t::const_iterator it;
+	if (!key.Contains("=")) return;
 	for (it=variables.begin(); it!=variables.end(); ++it) { 
 		TString const& varName = it->first;
-		double value = it->second;
-		if (!key.Contains("=") || !key.Contains(varName) ) continue;
+		if (!key.Contains(varName) ) continue;
 		if (debug >= 3) {
 			std::cout.precision(prec);
 			std::cout << "REPL '" << varName << "' => " << prec << std::endl;
 		}
-		stream.str("");
-		stream.clear();	
-		if(0) { stream << scientific << value;} else {stream << value;}
-		stream >> varValue;
-		do {
-			i = key.Index(varName);
-			if (i>0) {
-				temp = key;
-				temp.Remove(i);
-				temp += varValue;
-				key.Replace(0,i+varName.Length(),"");
-				temp += key;
-				key = temp;
-			}
-		} while (i>0);
+		substituteVariable(key,varName,variableText(it->second));
 	}
 }
 
@@ -98,6 +121,159 @@ void replaceKeyword(TString &key, TString word, TString keyword){
 
 }
 
+// Evaluates the arithmetic the geometry files use (numbers, + - * /, brackets
+// and the common math functions) without going through TFormula. Anything
+// else, including integer division which would follow C++ rules in TFormula,
+// is reported as not handled so the caller can fall back to TFormula.
+class ExprEvaluator{
+	public:
+		ExprEvaluator(const char* expr): s(expr), pos(0), ok(true) {}
+
+		bool eval(double &value){
+			bool isInt;
+			value = parseSum(isInt);
+			skipSpace();
+			return ok && s[pos]=='\0';
+		}
+
+	private:
+		const char* s;
+		size_t pos;
+		bool ok;
+
+		void skipSpace(){ while(s[pos]==' ' || s[pos]=='\t') pos++; }
+
+		// Integer arithmetic only stays exact as double while it fits an int
+		double checkInt(double value){
+			if(std::fabs(value) > INT_MAX) ok = false;
+			return value;
+		}
+
+		double parseSum(bool &isInt){
+			double value = parseProduct(isInt);
+			while(ok){
+				skipSpace();
+				char op = s[pos];
+				if(op!='+' && op!='-') break;
+				pos++;
+				bool rhsInt;
+				double rhs = parseProduct(rhsInt);
+				value = (op=='+') ? value+rhs : value-rhs;
+				isInt = isInt && rhsInt;
+				if(isInt) checkInt(value);
+			}
+			return value;
+		}
+
+		double parseProduct(bool &isInt){
+			double value = parseUnary(isInt);
+			while(ok){
+				skipSpace();
+				char op = s[pos];
+				if(op!='*' && op!='/') break;
+				pos++;
+				bool rhsInt;
+				double rhs = parseUnary(rhsInt);
+				if(op=='/' && isInt && rhsInt) { ok = false; break; }
+				value = (op=='*') ? value*rhs : value/rhs;
+				isInt = isInt && rhsInt;
+				if(isInt) checkInt(value);
+			}
+			return value;
+		}
+
+		double parseUnary(bool &isInt){
+			skipSpace();
+			if(s[pos]=='-') { pos++; return -parseUnary(isInt); }
+			if(s[pos]=='+') { pos++; return parseUnary(isInt); }
+			return parsePrimary(isInt);
+		}
+
+		double parsePrimary(bool &isInt){
+			skipSpace();
+			isInt = false;
+			if(s[pos]=='('){
+				pos++;
+				double value = parseSum(isInt);
+				skipSpace();
+				if(s[pos]!=')') { ok = false; return 0; }
+				pos++;
+				return value;
+			}
+			if(isdigit(s[pos]) || s[pos]=='.') return parseNumber(isInt);
+			if(isalpha(s[pos])) return parseFunction();
+			ok = false;
+			return 0;
+		}
+
+		double parseNumber(bool &isInt){
+			size_t start = pos;
+			bool isReal = false;
+			while(isdigit(s[pos])) pos++;
+			if(s[pos]=='.') { isReal = true; pos++; while(isdigit(s[pos])) pos++; }
+			if(s[pos]=='e' || s[pos]=='E'){
+				isReal = true;
+				pos++;
+				if(s[pos]=='+' || s[pos]=='-') pos++;
+				if(!isdigit(s[pos])) { ok = false; return 0; }
+				while(isdigit(s[pos])) pos++;
+			}
+			if(isalpha(s[pos]) || s[pos]=='_') { ok = false; return 0; }
+			std::string number(s+start, pos-start);
+			if(number==".") { ok = false; return 0; }
+			isInt = !isReal;
+			double value = strtod(number.c_str(), NULL);
+			return isInt ? checkInt(value) : value;
+		}
+
+		double parseFunction(){
+			size_t start = pos;
+			while(isalnum(s[pos]) || s[pos]=='_') pos++;
+			std::string name(s+start, pos-start);
+			skipSpace();
+			if(s[pos]!='(') { ok = false; return 0; }
+			pos++;
+			std::vector<double> args;
+			while(ok){
+				bool argInt;
+				args.push_back(parseSum(argInt));
+				skipSpace();
+				if(s[pos]!=',') break;
+				pos++;
+			}
+			if(!ok || s[pos]!=')') { ok = false; return 0; }
+			pos++;
+			if(args.size()==1){
+				double x = args[0];
+				if(name=="sin") return std::sin(x);
+				if(name=="cos") return std::cos(x);
+				if(name=="tan") return std::tan(x);
+				if(name=="asin") return std::asin(x);
+				if(name=="acos") return std::acos(x);
+				if(name=="atan") return std::atan(x);
+				if(name=="sqrt") return std::sqrt(x);
+				if(name=="exp") return std::exp(x);
+				if(name=="log") return std::log(x);
+			} else if(args.size()==2){
+				if(name=="pow") return std::pow(args[0], args[1]);
+				if(name=="atan2") return std::atan2(args[0], args[1]);
+			}
+			ok = false;
+			return 0;
+		}
+};
+
+double evalExpression(TString const& expr){
+
+	double value;
+	ExprEvaluator evaluator(expr.Data());
+	if(evaluator.eval(value)) return value;
+
+	if (debug >= 2) std::cout << "TFormula used for '" << expr << "'" << std::endl;
+	TFormula formula("",expr);
+	return formula.Eval(0);
+}
+
 void getVariable(TString key, Variables_t& variables){
 
 	TString name;
@@ -117,9 +293,8 @@ void getVariable(TString key, Variables_t& variables){
 	TString varValue = key;
 	varValue.Remove(pos);
 
-	TFormula formula("formula",varValue);
 	name = varName;
-	double value = formula.Eval(0);
+	double value = evalExpression(varValue);
 
 	if (debug >= 2) {
 		std::cout.precision(prec);
@@ -142,7 +317,7 @@ void evalFormulas(TString &key){
 	"xOffset=\"","yOffset=\"","scalingFactor=\"","v1x=\"","v1y=\"","v2x=\"","v2y=\"","v3x=\"","v3y=\"","v4x=\"","v4y=\"","v5x=\"","v5y=\"",
 	"v6x=\"","v6y=\"","v7x=\"","v7y=\"","v8x=\"","v8y=\"","dz=\""};
 
-
+	if(!key.Contains("=\"")) return;
 
 	for(int i=0; i<n; i++)
 	if(key.Contains(lookFor[i])){
@@ -152,8 +327,7 @@ void evalFormulas(TString &key){
 		pos2 = key.First("\"");
 		TString varFormula = key;
 		varFormula.Remove(pos2);
-		TFormula formula("",varFormula);
-		double value = formula.Eval(0);
+		double value = evalExpression(varFormula);
 		if (debug >= 2) {
 			std::cout.precision(prec);
 			std::cout << "FML " << lookFor[i] << "='" << varFormula << "' => " << value << std::endl;
@@ -171,6 +345,61 @@ void evalFormulas(TString &key){
 
 }
 
+// Replaces the variables in a loop body line once, as replaceVariable would,
+// leaving a slot wherever the loop variable goes
+void compileLoopLine(TString key, Variables_t const& variables, std::string const& loopVar, aLoopLine &line){
+
+	line.original = key.Data();
+	line.segments.clear();
+	line.usable = true;
+
+	Variables_t::const_iterator it;
+	if (key.Contains("=")) {
+		for (it=variables.begin(); it!=variables.end(); ++it) { 
+			TString const& varName = it->first;
+			if (!key.Contains(varName) ) continue;
+			if (it->first==loopVar) substituteVariable(key,varName,TString(loopSlot));
+			else substituteVariable(key,varName,variableText(it->second));
+		}
+	}
+
+	std::string text = key.Data();
+	size_t start = 0, pos;
+	while ((pos = text.find(loopSlot, start)) != std::string::npos) {
+		line.segments.push_back(text.substr(start, pos-start));
+		start = pos+1;
+	}
+	line.segments.push_back(text.substr(start));
+}
+
+// The slots are only equivalent to replacing the loop variable in place when
+// its printed value cannot itself make up part of a variable name handled
+// from that point on; these are the names to look for after the value is in
+std::vector<std::string> loopCheckNames(Variables_t const& variables, std::string const& loopVar){
+
+	std::vector<std::string> names;
+	Variables_t::const_iterator it = variables.find(loopVar);
+	for (; it!=variables.end(); ++it) {
+		if (it->first.find_first_of("0123456789.+-") != std::string::npos) names.push_back(it->first);
+	}
+	return names;
+}
+
+bool fillLoopLine(aLoopLine const& line, TString const& varValue, std::vector<std::string> const& checkNames, TString &key){
+
+	if (!line.usable) return false;
+	std::string text = line.segments[0];
+	for (size_t i=1; i<line.segments.size(); i++) {
+		text += varValue.Data();
+		text += line.segments[i];
+	}
+	if (line.segments.size()>1) {
+		for (auto const& name : checkNames) if (text.find(name) != std::string::npos) return false;
+	}
+	key = text.c_str();
+	return true;
+}
+
 void makeLoop(TString &key, aLoop &theLoop){
 	int pos = key.Index("for")+3;
 	key.Replace(0,pos,"");
@@ -276,6 +505,7 @@ int preparse(TString inName="sbnd_base.gdml", TString outName1="sbnd.gdml", TStr
 	SetDefaultVariables(variables);
 	
 	std::vector<std::string> loopLine;
+	std::vector<aLoopLine> loopTemplate;
 	aLoop theLoop;
 
 	std::vector<aSetup> stpList;
@@ -296,10 +526,22 @@ int preparse(TString inName="sbnd_base.gdml", TString outName1="sbnd.gdml", TStr
 			if(key.Contains("#wire")) isWire=1;
 			makeLoop(key,theLoop);
 		} else if (key.Contains("</loop")) {
+			// The body is parsed once, only the loop variable changes between iterations
+			bool loopVarDefined = (variables.count(theLoop.varName) > 0);
+			loopTemplate.resize(loopLine.size());
+			for (size_t iLine=0; iLine<loopLine.size(); iLine++) {
+				compileLoopLine(loopLine[iLine],variables,theLoop.varName,loopTemplate[iLine]);
+				loopTemplate[iLine].usable = loopVarDefined;
+			}
+			std::vector<std::string> checkNames = loopCheckNames(variables,theLoop.varName);
 			do{
-				for (std::vector<std::string>::iterator it = loopLine.begin() ; it != loopLine.end(); ++it){
-					loopkey = *it;
-					replaceVariable(loopkey,variables);
+				TString varValue = variableText(variables[theLoop.varName]);
+				bool plainValue = !varValue.IsNull() && (strspn(varValue.Data(),"0123456789.+-") == (size_t)varValue.Length());
+				for (std::vector<aLoopLine>::iterator it = loopTemplate.begin() ; it != loopTemplate.end(); ++it){
+					if (!plainValue || !fillLoopLine(*it,varValue,checkNames,loopkey)) {
+						loopkey = it->original.c_str();
+						replaceVariable(loopkey,variables);
+					}
 					if(loopkey.Contains("--")) {
 					  if (debug) {
 					    std::cout << "checking double minus sign " << std::endl;
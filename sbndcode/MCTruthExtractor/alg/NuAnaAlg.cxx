@@ -696,15 +696,11 @@ namespace sbnd{
       // This is getting the flux weights from the flux object.
       // It's a total hack, it's hardcoded, and requires a custom version of 
       // the nutools software.  
-      eventReweight.clear();
       eventReweight.resize(7);
       for (int i = 0; i < 7; i ++)
       {
-        eventReweight[i].resize(1000);
-        for (int j = 0; j < 1000; ++j)
-        {
-          eventReweight[i][j]=flux->eventReweight[i*1000+j];
-        }
+        auto const* first = &flux->eventReweight[i*1000];
+        eventReweight[i].assign(first, first + 1000);
       }
 
       return;
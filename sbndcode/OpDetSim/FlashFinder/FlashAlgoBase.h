@@ -16,6 +16,8 @@ namespace lightana
     virtual ~FlashAlgoBase();
     virtual void Configure(const Config_t &p) = 0;
     virtual LiteOpFlashArray_t RecoFlash(const LiteOpHitArray_t ophits) = 0;
+    /// OpChannels the algo was configured to use, in index order
+    virtual const std::vector<int>& OpChannels() const = 0;
     virtual void Reset();
 
   private:
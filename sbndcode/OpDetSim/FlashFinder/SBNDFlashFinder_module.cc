@@ -19,9 +19,15 @@
 #include "lardataobj/RecoBase/OpHit.h"
 #include "lardataobj/RecoBase/OpFlash.h"
 #include "lardata/Utilities/AssociationUtil.h"
+#include "larcore/Geometry/Geometry.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
 
 #include <memory>
 #include <string>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <cmath>
 #include "FlashFinderManager.h"
 #include "FlashFinderFMWKInterface.h"
 #include "PECalib.h"
@@ -53,7 +59,15 @@ namespace opdet{
     std::string _flash_producer;
     std::string _hit_producer;
 
+    // Split mode: hits are partitioned by TPC and each TPC runs its own flash algo
+    bool _split_by_tpc;
+    std::vector<int> _opch_to_tpc;                         // TPC facing each OpChannel, -1 if none
+    std::vector<::lightana::FlashFinderManager> _tpc_mgr;  // one flash algo per TPC
+    size_t _n_channel_pe;                                  // channel_pe length of a full detector flash
+
     void GetFlashLocation(std::vector<double>, double&, double&, double&, double&);
+    void FillOpChannelToTPC();
+    ::lightana::LiteOpFlashArray_t RecoFlashByTPC(const ::lightana::LiteOpHitArray_t& ophits);
 
   };
 
@@ -64,11 +78,38 @@ namespace opdet{
     _hit_producer   = p.get<std::string>("OpHitProducer");
     _flash_producer = p.get<std::string>("OpFlashProducer");
   
+    _split_by_tpc   = p.get<bool>("SplitByTPC", false);
+    _n_channel_pe   = 0;
+  
     auto const flash_algo  = p.get<std::string>("FlashFinderAlgo");
     auto const flash_pset = p.get<lightana::Config_t>("AlgoConfig");
     auto algo_ptr = ::lightana::FlashAlgoFactory::get().create(flash_algo,flash_algo);
     algo_ptr->Configure(flash_pset);
     _mgr.SetFlashAlgo(algo_ptr);
+    if(_split_by_tpc) {
+      // Give each TPC an algo restricted to the configured channels facing it
+      FillOpChannelToTPC();
+      auto const& opch_v = algo_ptr->OpChannels();
+      _n_channel_pe = opch_v.empty() ? 0 : *std::max_element(opch_v.begin(), opch_v.end()) + 1;
+      int ntpc = 0;
+      for(auto const& tpc : _opch_to_tpc) ntpc = std::max(ntpc, tpc + 1);
+      for(int tpc=0; tpc<ntpc; ++tpc) {
+        std::vector<int> tpc_opch_v;
+        for(auto const& opch : opch_v) {
+          if(opch >= 0 && opch < (int)_opch_to_tpc.size() && _opch_to_tpc[opch] == tpc) tpc_opch_v.push_back(opch);
+        }
+        if(tpc_opch_v.empty()) {
+          std::cerr << "No configured OpChannel faces TPC " << tpc << "!" << std::endl;
+          throw std::exception();
+        }
+        auto tpc_pset = flash_pset;
+        tpc_pset.put_or_replace("OpChannel", tpc_opch_v);
+        auto tpc_algo_ptr = ::lightana::FlashAlgoFactory::get().create(flash_algo, flash_algo + "TPC" + std::to_string(tpc));
+        tpc_algo_ptr->Configure(tpc_pset);
+        _tpc_mgr.emplace_back();
+        _tpc_mgr.back().SetFlashAlgo(tpc_algo_ptr);
+      }
+    }
     _pecalib.Configure(p.get<lightana::Config_t>("PECalib"));
 
     produces< std::vector<recob::OpFlash>   >();
@@ -104,7 +145,7 @@ namespace opdet{
       ophits.emplace_back(std::move(loph));
     }
   
-    auto const flash_v = _mgr.RecoFlash(ophits);
+    auto const flash_v = _split_by_tpc ? RecoFlashByTPC(ophits) : _mgr.RecoFlash(ophits);
 
     for(const auto& lflash :  flash_v) {
 
@@ -126,6 +167,63 @@ namespace opdet{
     e.put(std::move(flash2hit_assn_v));
   }
 
+  // Each optical detector sees the TPC whose centre is closest in drift coordinate
+  void SBNDFlashFinder::FillOpChannelToTPC()
+  {
+    ::art::ServiceHandle<geo::Geometry> geo;
+    auto const& cryostat = geo->Cryostat(0);
+    _opch_to_tpc.assign(geo->MaxOpChannel()+1, -1);
+    for(size_t opch=0; opch<=geo->MaxOpChannel(); ++opch) {
+      if(!geo->IsValidOpChannel(opch)) continue;
+      double xyz[3];
+      ::lightana::OpDetCenterFromOpChannel(opch, xyz);
+      double min_dist = std::numeric_limits<double>::max();
+      for(size_t tpc=0; tpc<cryostat.NTPC(); ++tpc) {
+        double dist = std::abs(xyz[0] - cryostat.TPC(tpc).GetCenter().X());
+        if(dist >= min_dist) continue;
+        min_dist = dist;
+        _opch_to_tpc[opch] = tpc;
+      }
+    }
+  }
+
+  // Run the per TPC algos concurrently, flashes are returned TPC by TPC in the order
+  // each algo made them and point back to the full hit list
+  ::lightana::LiteOpFlashArray_t SBNDFlashFinder::RecoFlashByTPC(const ::lightana::LiteOpHitArray_t& ophits)
+  {
+    size_t ntpc = _tpc_mgr.size();
+    std::vector< ::lightana::LiteOpHitArray_t > tpc_ophits(ntpc);
+    std::vector< std::vector<unsigned int> > tpc_hitidx(ntpc);
+    for(size_t hitidx=0; hitidx<ophits.size(); ++hitidx) {
+      auto const& oph = ophits[hitidx];
+      if(oph.channel >= _opch_to_tpc.size() || _opch_to_tpc[oph.channel] < 0) continue;
+      int tpc = _opch_to_tpc[oph.channel];
+      tpc_ophits[tpc].push_back(oph);
+      tpc_hitidx[tpc].push_back(hitidx);
+    }
+
+    std::vector< ::lightana::LiteOpFlashArray_t > tpc_flash_v(ntpc);
+    std::vector<std::thread> threads;
+    for(size_t tpc=1; tpc<ntpc; ++tpc) {
+      threads.emplace_back([this, tpc, &tpc_ophits, &tpc_flash_v]() {
+        tpc_flash_v[tpc] = _tpc_mgr[tpc].RecoFlash(tpc_ophits[tpc]);
+      });
+    }
+    if(ntpc > 0) tpc_flash_v[0] = _tpc_mgr[0].RecoFlash(tpc_ophits[0]);
+    for(auto& thread : threads) thread.join();
+
+    ::lightana::LiteOpFlashArray_t flash_v;
+    for(size_t tpc=0; tpc<ntpc; ++tpc) {
+      for(auto& lflash : tpc_flash_v[tpc]) {
+        for(auto& idx : lflash.asshit_idx) idx = tpc_hitidx[tpc][idx];
+        // the products keep the full detector channel layout
+        if(lflash.channel_pe.size() < _n_channel_pe) lflash.channel_pe.resize(_n_channel_pe, 0);
+        flash_v.emplace_back(std::move(lflash));
+      }
+    }
+    return flash_v;
+  }
+
   void SBNDFlashFinder::GetFlashLocation(std::vector<double> pePerOpChannel, double& Ycenter, double& Zcenter, double& Ywidth, double& Zwidth)
   {
 
@@ -113,10 +113,10 @@ namespace lightana{
         size_t max_ch = _opch_to_index_v.size() - 1;
         size_t NOpDet = _index_to_opch_v.size();
         
-        //static std::vector<double> pesum_v;
-        static std::vector<double> mult_v;  //< this is not strictly a multiplicity of PMTs, but multiplicity of hits
-        static std::vector<std::vector<double> > pespec_v;
-        static std::vector<std::vector<unsigned int> > hitidx_v;
+        // work buffers are members so that several instances can run at once
+        auto& mult_v   = _mult_v;  //< this is not strictly a multiplicity of PMTs, but multiplicity of hits
+        auto& pespec_v = _pespec_v;
+        auto& hitidx_v = _hitidx_v;
         double min_time=1.1e20;
         double max_time=1.1e20;
         for(auto const& oph : ophits) {
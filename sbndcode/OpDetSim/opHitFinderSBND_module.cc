@@ -40,6 +40,7 @@
 #include <memory>
 #include <algorithm>
 #include <vector>
+#include <utility>
 #include "TMath.h"
 #include "TH1D.h"
 #include "TRandom3.h"
@@ -80,6 +81,11 @@ namespace opdet {
     double fArea1pePMT; //area of 1 pe in ADC*ns for PMTs
     double fArea1peSiPM; //area of 1 pe in ADC*ns for Arapucas
     bool fUseDenoising;
+    bool fDenoiseROIOnly;          // denoise only regions that can hold a pulse
+    double fDenoiseLambda;         // TV1D regularisation
+    double fDenoiseROIThreshold;   // in ADC, on the smoothed waveform
+    int fDenoiseROISmoothing;      // in ticks, width of the moving average
+    int fDenoiseROIMargin;         // in ticks, added on each side of a region
     int fThresholdPMT; //in ADC
     int fThresholdArapuca; //in ADC
     int fEvNumber;
@@ -88,14 +94,27 @@ namespace opdet {
     int threshold;
     std::vector<double> fwaveform;
     std::vector<double> outwvform;
+    std::vector<std::pair<int, int>> fROIs; // [start, end) of the regions to denoise
+    std::vector<double> fROIIn;
+    std::vector<double> fROIOut;
+    std::vector<unsigned int> fIndStartLow; // TV1D_denoise_v2 work buffers
+    std::vector<unsigned int> fIndStartUp;
+    struct Pulse {
+      size_t timebin;    // first tick at the maximum
+      double area;       // in ADC*us
+      double amplitude;  // in ADC
+    };
+    std::vector<Pulse> fPulses; // pulses of the current waveform
     //int fSize;
     //int fTimePMT;         //Start time of PMT signal
     //int fTimeMax;         //Time of maximum (minimum) PMT signal
-    void subtractBaseline(std::vector<double>& waveform, std::string pdtype, double& rms);
+    void subtractBaseline(std::vector<double>& waveform, double polarity, double& rms);
     bool findAndSuppressPeak(std::vector<double>& waveform, size_t& timebin,
                              double& Area, double& amplitude,
-                             const int& threshold, const std::string& opdetType);
+                             const int& threshold);
+    void findPulses(const raw::OpDetWaveform& wvf, double polarity, const int& threshold);
     void denoise(std::vector<double>& waveform, std::vector<double>& outwaveform);
+    void denoiseROI(std::vector<double>& waveform, const int& threshold);
     bool TV1D_denoise(std::vector<double>& waveform,
                       std::vector<double>& outwaveform,
                       const double lambda);
@@ -118,6 +137,11 @@ namespace opdet {
     fPulsePolarityPMT = p.get< int   >("PulsePolarityPMT");
     fPulsePolarityArapuca = p.get<int>("PulsePolarityArapuca");
     fUseDenoising     = p.get< bool  >("UseDenoising");
+    fDenoiseROIOnly   = p.get< bool  >("DenoiseROIOnly", false);
+    fDenoiseLambda    = p.get< double>("DenoiseLambda", 10.);
+    fDenoiseROIThreshold = p.get< double >("DenoiseROIThreshold", 5.); //in ADC
+    fDenoiseROISmoothing = p.get< int >("DenoiseROISmoothing", 5); //in ticks
+    fDenoiseROIMargin    = p.get< int >("DenoiseROIMargin", 50); //in ticks
 
     auto const *timeService = lar::providerFrom< detinfo::DetectorClocksService >();
     fSampling = (timeService->OpticalClock().Frequency()); // MHz
@@ -160,66 +184,55 @@ namespace opdet {
 
       fChNumber = wvf.ChannelNumber();
       opdetType = map.pdType(fChNumber);
+      double polarity, area1pe;
+      bool useDenoising = false;
       if(opdetType == "pmt_coated" || opdetType == "pmt_uncoated") {
         threshold = fThresholdPMT;
+        polarity = fPulsePolarityPMT;
+        area1pe = fArea1pePMT;
       }
-      else if((opdetType == "arapuca_vuv") || (opdetType == "arapuca_vis")) {
-        threshold = fThresholdArapuca;
-      }
-      else if((opdetType == "xarapuca_vuv") || (opdetType == "xarapuca_vis")) {
+      else if((opdetType == "arapuca_vuv") || (opdetType == "arapuca_vis") ||
+              (opdetType == "xarapuca_vuv") || (opdetType == "xarapuca_vis")) {
         threshold = fThresholdArapuca;
+        polarity = fPulsePolarityArapuca;
+        area1pe = fArea1peSiPM;
+        useDenoising = fUseDenoising;
       }
       else {
         std::cout << "Unexpected OpChannel: " << opdetType << std::endl;
         continue;
       }
 
-      fwaveform.resize(wvf.size());
-      for(unsigned int i = 0; i < wvf.size(); i++) {
-        fwaveform[i] = wvf[i];
-      }
+      if(useDenoising) {
+        // denoising needs the whole baseline subtracted waveform
+        fwaveform.resize(wvf.size());
+        for(unsigned int i = 0; i < wvf.size(); i++) {
+          fwaveform[i] = wvf[i];
+        }
 
-      subtractBaseline(fwaveform, opdetType, rms);
+        subtractBaseline(fwaveform, polarity, rms);
 
-      if(fUseDenoising) {
-        if((opdetType == "pmt_coated") || (opdetType == "pmt_uncoated")) {
-        }
-        else if((opdetType == "arapuca_vuv") || (opdetType == "arapuca_vis")) {
-          denoise(fwaveform, outwvform);
-        }
-        else if((opdetType == "xarapuca_vuv") || (opdetType == "xarapuca_vis")) {
-          denoise(fwaveform, outwvform);
-        }
-        else {
-          std::cout << "Unexpected OpChannel: " << opdetType
-                    << ", continue." << std::endl;
-          std::terminate();
+        if(fDenoiseROIOnly) denoiseROI(fwaveform, threshold);
+        else denoise(fwaveform, outwvform);
+
+        // TODO: pass rms to this function once that's sorted. ~icaza
+        fPulses.clear();
+        while(findAndSuppressPeak(fwaveform, timebin, Area, amplitude, threshold)){
+          fPulses.push_back({timebin, Area, amplitude});
         }
       }
+      else {
+        findPulses(wvf, polarity, threshold);
+      }
 
-      // TODO: pass rms to this function once that's sorted. ~icaza
-      while(findAndSuppressPeak(fwaveform, timebin, Area, amplitude, threshold, opdetType)){
-        time = wvf.TimeStamp() + (double)timebin / fSampling;
-
-        if(opdetType == "pmt_coated" || opdetType == "pmt_uncoated") {
-          phelec = Area / fArea1pePMT;
-        }
-        else if((opdetType == "arapuca_vuv") || (opdetType == "arapuca_vis")) {
-          phelec = Area / fArea1peSiPM;
-        }
-        else if((opdetType == "xarapuca_vuv") || (opdetType == "xarapuca_vis")) {
-          phelec = Area / fArea1peSiPM;
-        }
-        else {
-          std::cout << "Unexpected OpChannel: " << opdetType
-                    << ", continue." << std::endl;
-          continue;
-        }
+      for(auto const& pulse : fPulses) {
+        time = wvf.TimeStamp() + (double)pulse.timebin / fSampling;
+        phelec = pulse.area / area1pe;
 
         //including hit info: OpChannel, PeakTime, PeakTimeAbs, Frame, Width, Area, PeakHeight, PE, FastToTotal
-        recob::OpHit opHit(fChNumber, time, time, frame, FWHM, Area, amplitude, phelec, fasttotal);
+        recob::OpHit opHit(fChNumber, time, time, frame, FWHM, pulse.area, pulse.amplitude, phelec, fasttotal);
         pulseVecPtr->emplace_back(opHit);
-      } // while findAndSuppressPeak()
+      } // for(auto const& pulse : fPulses)
     } // for(auto const& wvf : (*wvfHandle)){
     e.put(std::move(pulseVecPtr));
     std::vector<double>().swap(fwaveform); // clear and release the memory of fwaveform
@@ -229,7 +242,7 @@ namespace opdet {
   DEFINE_ART_MODULE(opHitFinderSBND)
 
   void opHitFinderSBND::subtractBaseline(std::vector<double>& waveform,
-                                         std::string pdtype, double& rms)
+                                         double polarity, double& rms)
   {
     double baseline = 0.0;
     rms = 0.0;
@@ -247,27 +260,62 @@ namespace opdet {
     rms = sqrt(rms / cnt - baseline * baseline);
     rms = rms / sqrt(cnt - 1);
 
-    if(pdtype == "pmt_coated" || pdtype == "pmt_uncoated") {
-      for(unsigned int i = 0; i < waveform.size(); i++) waveform[i] = fPulsePolarityPMT * (waveform[i] - baseline);
-    }
-    else if((opdetType == "arapuca_vuv") || (opdetType == "arapuca_vis")) {
-      for(unsigned int i = 0; i < waveform.size(); i++) waveform[i] = fPulsePolarityArapuca * (waveform[i] - baseline);
-    }
-    else if((opdetType == "xarapuca_vuv") || (opdetType == "xarapuca_vis")) {
-      for(unsigned int i = 0; i < waveform.size(); i++) waveform[i] = fPulsePolarityArapuca * (waveform[i] - baseline);
+    for(unsigned int i = 0; i < waveform.size(); i++) waveform[i] = polarity * (waveform[i] - baseline);
+  }
+
+
+  // Single pass over the raw samples: subtracts the baseline, finds the
+  // threshold crossings and integrates each pulse as it goes. Gives the
+  // same pulses, in the same order, as repeatedly calling
+  // findAndSuppressPeak() on the baseline subtracted waveform.
+  void opHitFinderSBND::findPulses(const raw::OpDetWaveform& wvf,
+                                   double polarity, const int& threshold)
+  {
+    fPulses.clear();
+
+    // TODO: same assumption as subtractBaseline(), the first
+    // samples are taken to be only noise.
+    size_t nbaseline = std::min((size_t)fBaselineSample, wvf.size());
+    double baseline = 0.0;
+    for(size_t i = 0; i < nbaseline; i++) baseline += wvf[i];
+    baseline = baseline / nbaseline;
+
+    bool inPulse = false;
+    Pulse pulse{0, 0., 0.};
+    for(size_t i = 0; i < wvf.size(); i++) {
+      double sample = polarity * (wvf[i] - baseline);
+      if(sample >= threshold) {
+        if(!inPulse) {
+          pulse = {i, 0., sample};
+          inPulse = true;
+        }
+        else if(sample > pulse.amplitude) {
+          pulse.amplitude = sample;
+          pulse.timebin = i;
+        }
+        pulse.area += sample;
+      }
+      else if(inPulse) {
+        pulse.area = pulse.area/fSampling;
+        fPulses.push_back(pulse);
+        inPulse = false;
+      }
     }
-    else {
-      std::cout << "Unexpected OpChannel: " << opdetType << std::endl;
-      return;
+    if(inPulse) {
+      pulse.area = pulse.area/fSampling;
+      fPulses.push_back(pulse);
     }
-  }
+
+    // highest pulse first, earliest first if equal
+    std::stable_sort(fPulses.begin(), fPulses.end(),
+                     [](const Pulse& a, const Pulse& b){ return a.amplitude > b.amplitude; });
+  } // void opHitFinderSBND::findPulses()
 
 
   // TODO: pass rms to this function once that's sorted. ~icaza
   bool opHitFinderSBND::findAndSuppressPeak(std::vector<double>& waveform,
                                             size_t& timebin, double& Area,
-                                            double& amplitude, const int& threshold,
-                                            const std::string& opdetType)
+                                            double& amplitude, const int& threshold)
   {
 
     std::vector<double>::iterator max_element_it = std::max_element(waveform.begin(), waveform.end());
@@ -304,7 +352,7 @@ namespace opdet {
 
     int wavelength = waveform.size();
     outwaveform = waveform;  // copy
-    double lambda = 10.0;
+    double lambda = fDenoiseLambda;
     const uint retries = 5; uint try_ = 0;
     if (wavelength > 0) {
       while (try_ <= retries) {
@@ -326,6 +374,43 @@ namespace opdet {
     }
   } // void opHitFinderSBND::denoise()
 
+  // Denoise only the regions where the smoothed waveform, or any single
+  // sample, reaches the thresholds, plus a margin on each side. The rest
+  // of the waveform is baseline and is left as it is.
+  void opHitFinderSBND::denoiseROI(std::vector<double>& waveform, const int& threshold)
+  {
+    int wavelength = waveform.size();
+    int half = fDenoiseROISmoothing / 2;
+
+    fROIs.clear();
+    double sum = 0.;
+    int lo = 0, hi = -1; // moving average over [lo, hi]
+    for(int i = 0; i < wavelength; i++) {
+      int newhi = std::min(i + half, wavelength - 1);
+      while(hi < newhi) sum += waveform[++hi];
+      int newlo = std::max(i - half, 0);
+      while(lo < newlo) sum -= waveform[lo++];
+      double smoothed = sum / (hi - lo + 1);
+      if(smoothed < fDenoiseROIThreshold && waveform[i] < threshold) continue;
+
+      int start = std::max(i - fDenoiseROIMargin, 0);
+      int end = std::min(i + fDenoiseROIMargin + 1, wavelength);
+      if(!fROIs.empty() && start <= fROIs.back().second) fROIs.back().second = end;
+      else fROIs.emplace_back(start, end);
+    }
+
+    for(auto const& roi : fROIs) {
+      unsigned int width = roi.second - roi.first;
+      fROIIn.assign(waveform.begin() + roi.first, waveform.begin() + roi.second);
+      fROIOut.resize(width);
+      // the non-recursive version always converges, no retries needed
+      TV1D_denoise_v2(fROIIn, fROIOut, width, fDenoiseLambda);
+      for(unsigned int i = 0; i < width; i++) {
+        if(fROIOut[i]) waveform[roi.first + i] = fROIOut[i];
+      }
+    }
+  } // void opHitFinderSBND::denoiseROI()
+
   // TODO: this function is not robust, check if the expected input is given and put exceptions
   bool opHitFinderSBND::TV1D_denoise(std::vector<double>& waveform,
                                      std::vector<double>& outwaveform,
@@ -387,8 +472,13 @@ namespace opdet {
   {
     // unsigned int* indstart_low = malloc(sizeof *indstart_low * width);
     // unsigned int* indstart_up = malloc(sizeof *indstart_up * width);
-    std::vector<unsigned int> indstart_low(width);
-    std::vector<unsigned int> indstart_up(width);
+    // buffers only grow, so they are allocated once for the longest input
+    if(fIndStartLow.size() < width) {
+      fIndStartLow.resize(width);
+      fIndStartUp.resize(width);
+    }
+    std::vector<unsigned int>& indstart_low = fIndStartLow;
+    std::vector<unsigned int>& indstart_up = fIndStartUp;
     unsigned int j_low = 0, j_up = 0, jseg = 0, indjseg = 0, i = 1, indjseg2, ind;
     double output_low_first = input[0] - lambda;
     double output_low_curr = output_low_first;
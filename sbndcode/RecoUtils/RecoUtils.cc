@@ -1,5 +1,90 @@
 #include "RecoUtils.h"
 
+#include <cmath>
+#include <limits>
+
+namespace {
+
+  // Flat accumulators used by the cached truth matching. The number of contributing particles
+  // per hit or per object is small so a linear search beats a node-based map.
+  template<typename T>
+  void AddToFlatMap(std::vector<std::pair<int,T> >& flat_map, int id, T value){
+    for (auto& entry : flat_map){
+      if (entry.first == id){
+        entry.second += value;
+        return;
+      }
+    }
+    flat_map.emplace_back(id, value);
+  }
+
+  // Returns the id with the largest value above start_value, resolving ties towards the lowest
+  // id to match the ordering of the std::map based functions
+  template<typename T>
+  int MaxFlatMapID(const std::vector<std::pair<int,T> >& flat_map, T start_value, int default_id){
+    T max_value = start_value;
+    int max_id = default_id;
+    bool found = false;
+    for (auto const& entry : flat_map){
+      if (entry.second > max_value || (found && entry.second == max_value && entry.first < max_id)){
+        max_value = entry.second;
+        max_id = entry.first;
+        found = true;
+      }
+    }
+    return max_id;
+  }
+
+  // Length of the segment start + t*dir, t in [0,1], which lies inside the box
+  double ClippedLength(const double p0[3], const double dir[3], const double min[3], const double max[3]){
+    double t_enter = 0.;
+    double t_exit = 1.;
+    for (int i = 0; i < 3; i++){
+      if (dir[i] == 0.){
+        if (p0[i] < min[i] || p0[i] > max[i]) return 0.;
+        continue;
+      }
+      double t0 = (min[i] - p0[i]) / dir[i];
+      double t1 = (max[i] - p0[i]) / dir[i];
+      if (t0 > t1) std::swap(t0, t1);
+      if (t0 > t_enter) t_enter = t0;
+      if (t1 < t_exit) t_exit = t1;
+      if (t_enter >= t_exit) return 0.;
+    }
+    return (t_exit - t_enter) * std::sqrt(dir[0]*dir[0] + dir[1]*dir[1] + dir[2]*dir[2]);
+  }
+
+}
+
+void RecoUtils::TruthMatchCache::Reset(){
+  fHitTruth.clear();
+}
+
+const RecoUtils::TruthMatchCache::HitTruth& RecoUtils::TruthMatchCache::GetHitTruth(const art::Ptr<recob::Hit>& hit){
+  std::vector<HitTruth>& product_truth = fHitTruth[hit.id()];
+  if (hit.key() >= product_truth.size()) product_truth.resize(hit.key()+1);
+  HitTruth& hit_truth = product_truth[hit.key()];
+  if (hit_truth.filled) return hit_truth;
+
+  art::ServiceHandle<cheat::BackTrackerService> bt_serv;
+  std::vector<sim::TrackIDE> track_ides = bt_serv->HitToTrackIDEs(hit);
+  hit_truth.id_energies.reserve(track_ides.size());
+  std::vector<std::pair<int,double> > signed_energies, rollup_energies;
+  signed_energies.reserve(track_ides.size());
+  rollup_energies.reserve(track_ides.size());
+  for (auto const& ide : track_ides){
+    hit_truth.id_energies.emplace_back(ide.trackID, ide.energy);
+    AddToFlatMap(signed_energies, ide.trackID, (double)ide.energy);
+    AddToFlatMap(rollup_energies, std::abs(ide.trackID), (double)ide.energy);
+  }
+
+  hit_truth.dominant_id = MaxFlatMapID(signed_energies, -99999., 0);
+  hit_truth.dominant_rollup_id = MaxFlatMapID(rollup_energies, -99999., 0);
+  hit_truth.filled = true;
+  return hit_truth;
+}
+
+
 
 int RecoUtils::TrueParticleID(const art::Ptr<recob::Hit> hit, bool rollup_unsaved_ids) {
   std::map<int,double> id_to_energy_map;
@@ -162,25 +247,169 @@ bool RecoUtils::IsInsideTPC(TVector3 position, double distance_buffer){
 }
 
 double RecoUtils::CalculateTrackLength(const art::Ptr<recob::Track> track){
+  if (track->NumberTrajectoryPoints() < 2) return 0; //Nothing to calculate if there is only one point
+
+  //The geometry is fixed for the job so the envelope is made on the first call and never changed
+  static const TPCEnvelope envelope;
+  return CalculateTrackLength(track, envelope);
+}
+
+double RecoUtils::CalculateTrackLength(const art::Ptr<recob::Track> track, const TPCEnvelope& envelope){
   double length = 0;
-  if (track->NumberTrajectoryPoints()==1) return length; //Nothing to calculate if there is only one point
+  if (track->NumberTrajectoryPoints() < 2) return length; //Nothing to calculate if there is only one point
+
+  unsigned int n_skipped = 0;
 
   for (size_t i_tp = 0; i_tp < track->NumberTrajectoryPoints()-1; i_tp++){ //Loop from the first to 2nd to last point
-    TVector3 this_point(track->TrajectoryPoint(i_tp).position.X(),track->TrajectoryPoint(i_tp).position.Y(),track->TrajectoryPoint(i_tp).position.Z());
-    if (!RecoUtils::IsInsideTPC(this_point,0)){
-      std::cout<<"RecoUtils::CalculateTrackLength - Current trajectory point not in the TPC volume.  Skip over this point in the track length calculation"<<std::endl;
+    const geo::Point_t this_point = track->LocationAtPoint(i_tp);
+    if (!envelope.IsInsideTPC(this_point,0)){
+      n_skipped++;
       continue;
     }
-    TVector3 next_point(track->TrajectoryPoint(i_tp+1).position.X(),track->TrajectoryPoint(i_tp+1).position.Y(),track->TrajectoryPoint(i_tp+1).position.Z());
-    if (!RecoUtils::IsInsideTPC(next_point,0)){
-      std::cout<<"RecoUtils::CalculateTrackLength - Next trajectory point not in the TPC volume.  Skip over this point in the track length calculation"<<std::endl;
+    const geo::Point_t next_point = track->LocationAtPoint(i_tp+1);
+    if (!envelope.IsInsideTPC(next_point,0)){
+      n_skipped++;
       continue;
     }
 
-    length+=(next_point-this_point).Mag();
+    length+=(next_point-this_point).R();
+  }
+
+  //One message per track, its own category so it can be limited in the message facility configuration
+  if (n_skipped > 0){
+    mf::LogWarning("RecoUtilsTrackLength") << "RecoUtils::CalculateTrackLength - " << n_skipped << " trajectory points not in the TPC volume.  Skipped over these points in the track length calculation";
   }
   return length;
 }
 
+double RecoUtils::CalculateContainedTrackLength(const recob::Track& track, const TPCEnvelope& envelope){
+  double length = 0;
+  if (track.NumberTrajectoryPoints() < 2) return length; //Nothing to calculate if there is only one point
 
+  for (size_t i_tp = 0; i_tp < track.NumberTrajectoryPoints()-1; i_tp++){
+    length += envelope.ContainedLength(track.LocationAtPoint(i_tp), track.LocationAtPoint(i_tp+1));
+  }
+  return length;
+}
+
+
+
+RecoUtils::TPCEnvelope::TPCEnvelope(){
+  art::ServiceHandle<geo::Geometry> geom;
+  Fill(*geom);
+}
 
+RecoUtils::TPCEnvelope::TPCEnvelope(const geo::GeometryCore& geom){
+  Fill(geom);
+}
+
+void RecoUtils::TPCEnvelope::Fill(const geo::GeometryCore& geom){
+  fMinX = fMinY = fMinZ = std::numeric_limits<double>::max();
+  fMaxX = fMaxY = fMaxZ = std::numeric_limits<double>::lowest();
+  fTPCBoxes.clear();
+
+  for (size_t c = 0; c < geom.Ncryostats(); c++)
+  {
+    const geo::CryostatGeo& cryostat = geom.Cryostat(c);
+    for (size_t t = 0; t < cryostat.NTPC(); t++)
+    {
+      const geo::TPCGeo& tpcg = cryostat.TPC(t);
+      if (tpcg.MinX() < fMinX) fMinX = tpcg.MinX();
+      if (tpcg.MaxX() > fMaxX) fMaxX = tpcg.MaxX();
+      if (tpcg.MinY() < fMinY) fMinY = tpcg.MinY();
+      if (tpcg.MaxY() > fMaxY) fMaxY = tpcg.MaxY();
+      if (tpcg.MinZ() < fMinZ) fMinZ = tpcg.MinZ();
+      if (tpcg.MaxZ() > fMaxZ) fMaxZ = tpcg.MaxZ();
+      fTPCBoxes.emplace_back(tpcg.MinX(), tpcg.MaxX(), tpcg.MinY(), tpcg.MaxY(), tpcg.MinZ(), tpcg.MaxZ());
+    }
+  }
+}
+
+bool RecoUtils::TPCEnvelope::IsInsideTPC(const geo::Point_t& position, double distance_buffer) const{
+  //Same tolerance as geo::GeometryCore::FindTPCAtPosition
+  const double wiggle = 1. + 1.e-4;
+  bool inTPC = false;
+  for (auto const& box : fTPCBoxes){
+    if (box.ContainsPosition(position, wiggle)){
+      inTPC = true;
+      break;
+    }
+  }
+  if (!inTPC) return false;
+
+  const double x = position.X(), y = position.Y(), z = position.Z();
+  return (x > fMinX) && (x < fMaxX) && (fabs(fMinX - x) > distance_buffer) && (fabs(x - fMaxX) > distance_buffer)
+      && (y > fMinY) && (y < fMaxY) && (fabs(fMaxY - y) > distance_buffer) && (fabs(y - fMinY) > distance_buffer)
+      && (z > fMinZ) && (z < fMaxZ) && (fabs(fMaxZ - z) > distance_buffer) && (fabs(z - fMinZ) > distance_buffer);
+}
+
+double RecoUtils::TPCEnvelope::ContainedLength(const geo::Point_t& start, const geo::Point_t& end) const{
+  //Clip the segment against each TPC, the TPCs don't overlap so the pieces add up
+  const double p0[3] = {start.X(), start.Y(), start.Z()};
+  const double dir[3] = {end.X()-start.X(), end.Y()-start.Y(), end.Z()-start.Z()};
+
+  double length = 0.;
+  for (auto const& box : fTPCBoxes){
+    const double min[3] = {box.MinX(), box.MinY(), box.MinZ()};
+    const double max[3] = {box.MaxX(), box.MaxY(), box.MaxZ()};
+    length += ClippedLength(p0, dir, min, max);
+  }
+  return length;
+}
+
+
+int RecoUtils::TrueParticleID(TruthMatchCache& cache, const art::Ptr<recob::Hit>& hit, bool rollup_unsaved_ids) {
+  const TruthMatchCache::HitTruth& hit_truth = cache.GetHitTruth(hit);
+  return rollup_unsaved_ids ? hit_truth.dominant_rollup_id : hit_truth.dominant_id;
+}
+
+
+
+int RecoUtils::TrueParticleIDFromTotalTrueEnergy(TruthMatchCache& cache, const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids) {
+  std::vector<std::pair<int,double> > trackIDToEDep;
+  for (auto const& hit : hits) {
+    for (auto const& id_energy : cache.GetHitTruth(hit).id_energies) {
+      int id = id_energy.first;
+      if (rollup_unsaved_ids) id = std::abs(id);
+      AddToFlatMap(trackIDToEDep, id, id_energy.second);
+    }
+  }
+  return MaxFlatMapID(trackIDToEDep, -1., -99999);
+}
+
+
+
+int RecoUtils::TrueParticleIDFromTotalRecoCharge(TruthMatchCache& cache, const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids) {
+  std::vector<std::pair<int,double> > trackCharge;
+  for (auto const& hit : hits) {
+    AddToFlatMap(trackCharge, TrueParticleID(cache, hit, rollup_unsaved_ids), (double)hit->Integral());
+  }
+  return MaxFlatMapID(trackCharge, 0., -99999);
+}
+
+
+
+int RecoUtils::TrueParticleIDFromTotalRecoHits(TruthMatchCache& cache, const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids) {
+  std::vector<std::pair<int,int> > trackHits;
+  for (auto const& hit : hits) {
+    AddToFlatMap(trackHits, TrueParticleID(cache, hit, rollup_unsaved_ids), 1);
+  }
+
+  int objectTrack = MaxFlatMapID(trackHits, -1, -99999);
+  int highestCount = -1;
+  int NHighestCounts = 0;
+  for (auto const& entry : trackHits) {
+    if (entry.second > highestCount) {
+      highestCount = entry.second;
+      NHighestCounts = 1;
+    }
+    else if (entry.second == highestCount){
+      NHighestCounts++;
+    }
+  }
+  if (NHighestCounts > 1){
+    std::cout<<"RecoUtils::TrueParticleIDFromTotalRecoHits - There are " << NHighestCounts << " particles which tie for highest number of contributing hits (" << highestCount<<" hits).  Using RecoUtils::TrueParticleIDFromTotalTrueEnergy instead."<<std::endl;
+    objectTrack = RecoUtils::TrueParticleIDFromTotalTrueEnergy(cache, hits, rollup_unsaved_ids);
+  }
+  return objectTrack;
+}
@@ -32,23 +32,78 @@
 //#include "lardataobj/AnalysisBase/ParticleID.h"
 #include "larsim/MCCheater/BackTrackerService.h"
 #include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/BoxBoundedGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
 
 
 // c++
 #include <vector>
 #include <map>
+#include <utility>
 
 // ROOT
 #include "TTree.h"
 
 
 namespace RecoUtils{
+
+  // Per-event cache of the back-tracked truth of each hit, keyed by the hit product id and key.
+  // Each hit is back-tracked at most once per event however many objects it is shared by.
+  // Call Reset() at the start of every event (or construct a fresh cache per event).
+  class TruthMatchCache {
+    public:
+      struct HitTruth {
+        bool filled = false;
+        int dominant_id = 0;        //Dominant true id using the signed geant4 ids
+        int dominant_rollup_id = 0; //Dominant true id with unsaved daughters rolled up into their saved ancestor
+        std::vector<std::pair<int,double> > id_energies; //Signed geant4 id and the energy it deposited in the hit
+      };
+
+      void Reset(); //Drops all cached hits, to be called once per event
+      const HitTruth& GetHitTruth(const art::Ptr<recob::Hit>& hit); //Back-tracks the hit on first request and returns the cached truth afterwards
+
+    private:
+      std::map<art::ProductID, std::vector<HitTruth> > fHitTruth; //Hit truth per hit product, indexed by hit key
+  };
+
+  // Envelope of all the TPCs in the geometry, cached so that containment checks need no service lookups.
+  // The geometry does not change within a run so build it once per run (e.g. in beginRun) and reuse it.
+  class TPCEnvelope {
+    public:
+      TPCEnvelope(); //Takes the geometry from the art service
+      TPCEnvelope(const geo::GeometryCore& geom);
+
+      bool IsInsideTPC(const geo::Point_t& position, double distance_buffer) const; //Same as RecoUtils::IsInsideTPC: the position must be in one of the TPCs and further than distance_buffer from the envelope walls
+      double ContainedLength(const geo::Point_t& start, const geo::Point_t& end) const; //Length of the straight segment between start and end which lies inside the TPCs, gaps between TPCs (e.g. the cathode) are not counted
+
+      double MinX() const { return fMinX; }
+      double MaxX() const { return fMaxX; }
+      double MinY() const { return fMinY; }
+      double MaxY() const { return fMaxY; }
+      double MinZ() const { return fMinZ; }
+      double MaxZ() const { return fMaxZ; }
+
+    private:
+      void Fill(const geo::GeometryCore& geom);
+
+      double fMinX, fMaxX, fMinY, fMaxY, fMinZ, fMaxZ;
+      std::vector<geo::BoxBoundedGeo> fTPCBoxes; //Individual TPC volumes, to reproduce the FindTPCAtPosition check
+  };
+
   int TrueParticleID(const art::Ptr<recob::Hit> hit, bool rollup_unsaved_ids=1); //Returns the geant4 ID which contributes the most to a single reco hit.  The matching method looks for true particle which deposits the most true energy in the reco hit.  If rollup_unsaved_ids is set to true, any unsaved daughter than contributed energy to the hit has its energy included in its closest ancestor that was saved.
   int TrueParticleIDFromTotalTrueEnergy(const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids=1); //Returns the geant4 ID which contributes the most to the vector of hits.  The matching method looks for which true particle deposits the most true energy in the reco hits
   int TrueParticleIDFromTotalRecoCharge(const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids=1);  //Returns the geant4 ID which contributes the most to the vector of hits.  The matching method looks for which true particle contributes the most reconstructed charge to the hit selection (the reco charge of each hit is correlated with each maximally contributing true particle and summed)
   int TrueParticleIDFromTotalRecoHits(const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids=1);  //Returns the geant4 ID which contributes the most to the vector of hits.  The matching method looks for which true particle maximally contributes to the most reco hits
+  //Overloads of the above which take the back-tracked hit truth from a per-event cache
+  int TrueParticleID(TruthMatchCache& cache, const art::Ptr<recob::Hit>& hit, bool rollup_unsaved_ids=1);
+  int TrueParticleIDFromTotalTrueEnergy(TruthMatchCache& cache, const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids=1);
+  int TrueParticleIDFromTotalRecoCharge(TruthMatchCache& cache, const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids=1);
+  int TrueParticleIDFromTotalRecoHits(TruthMatchCache& cache, const std::vector<art::Ptr<recob::Hit> >& hits, bool rollup_unsaved_ids=1);
   bool IsInsideTPC(TVector3 position, double distance_buffer); //Checks if a position is within any of the TPCs in the geometry (user can define some distance buffer from the TPC walls)
-  double CalculateTrackLength(const art::Ptr<recob::Track> track); //Calculates the total length of a recob::track by summing up the distances between adjacent traj. points
+  double CalculateTrackLength(const art::Ptr<recob::Track> track); //Calculates the total length of a recob::track by summing up the distances between adjacent traj. points, segments with a point outside the TPCs are skipped.  The TPC envelope is made from the geometry on the first call
+  double CalculateTrackLength(const art::Ptr<recob::Track> track, const TPCEnvelope& envelope); //Same as above with a TPC envelope supplied by the caller
+  double CalculateContainedTrackLength(const recob::Track& track, const TPCEnvelope& envelope); //Calculates the total length of a recob::track inside the TPCs, clipping segments which cross the TPC walls rather than skipping them.  The gap between TPCs is not counted
 }
 
 #endif
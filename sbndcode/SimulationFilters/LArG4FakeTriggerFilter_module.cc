@@ -28,8 +28,12 @@ namespace filt{
 
       geo::GeometryCore const* fGeometryService;
 
-      bool IsInterestingParticle(const art::Ptr<simb::MCParticle> particle);
-      double EnergyInTPC(const art::Ptr<simb::MCParticle> particle);
+      // TPC boundaries, fixed for the job
+      double fXmin, fXmax, fYmin, fYmax, fZmin, fZmax;
+
+      bool IsInterestingParticle(const simb::MCParticle& particle);
+      bool InTPC(double x, double y, double z) const;
+      double EnergyInTPC(const simb::MCParticle& particle, double e_needed);
   };
 
 
@@ -39,6 +43,13 @@ namespace filt{
     this->reconfigure(pset);
 
     fGeometryService = lar::providerFrom<geo::Geometry>();
+
+    fXmin = -2.0 * fGeometryService->DetHalfWidth();
+    fXmax = 2.0 * fGeometryService->DetHalfWidth();
+    fYmin = -fGeometryService->DetHalfHeight();
+    fYmax = fGeometryService->DetHalfHeight();
+    fZmin = 0.;
+    fZmax = fGeometryService->DetLength();
   }
 
 
@@ -59,24 +70,24 @@ namespace filt{
     e.getByLabel(fLArG4ModuleName, particles);
 
     double e_dep = 0;
+    double e_trig = fEnergyDeposit/1000.; // [GeV]
 
-    for (unsigned int part_i = 0; part_i < particles->size(); part_i++){
-
-      const art::Ptr<simb::MCParticle> particle(particles, part_i);
+    for (auto const& particle : *particles){
 
       // Check particle time is within the beam time
-      double time = particle->T() * 1e-3; // [us]
+      double time = particle.T() * 1e-3; // [us]
       if(time < fBeamTimeMin || time > fBeamTimeMax) continue;
 
       // Check particle is stable and charged
       if (!IsInterestingParticle(particle)) continue;
       
       // Add up the energy deposit inside the TPC
-      e_dep += EnergyInTPC(particle); // [GeV]
+      e_dep += EnergyInTPC(particle, e_trig - e_dep); // [GeV]
+
+      // If the energy deposit within the beam time is greater than some limit then trigger the event
+      if(e_dep > e_trig) return true;
     }
 
-    // If the energy deposit within the beam time is greater than some limit then trigger the event
-    if(e_dep > fEnergyDeposit/1000.) return true;
     return false;
 
   }
@@ -87,38 +98,37 @@ namespace filt{
 
 
   // Check if particle is stable and charged
-  bool LArG4FakeTriggerFilter::IsInterestingParticle(const art::Ptr<simb::MCParticle> particle){
+  bool LArG4FakeTriggerFilter::IsInterestingParticle(const simb::MCParticle& particle){
 
     // Stable final state
-    if(particle->StatusCode() != 1) return false;
+    if(particle.StatusCode() != 1) return false;
 
     // Charged: e, mu, pi, K, p
-    int pdg = particle->PdgCode();
+    int pdg = particle.PdgCode();
     if(!(pdg==11 || pdg==13 || pdg==211 || pdg==321 || pdg==2212)) return false;
 
     return true;
 
   }
 
-  // Add up energy deposit in TPC
-  double LArG4FakeTriggerFilter::EnergyInTPC(const art::Ptr<simb::MCParticle> particle){
+  // Check if a point is within the TPC
+  bool LArG4FakeTriggerFilter::InTPC(double x, double y, double z) const{
+    return x >= fXmin && x <= fXmax && y >= fYmin && y <= fYmax && z >= fZmin && z <= fZmax;
+  }
 
-    double xmin = -2.0 * fGeometryService->DetHalfWidth();
-    double xmax = 2.0 * fGeometryService->DetHalfWidth();
-    double ymin = -fGeometryService->DetHalfHeight();
-    double ymax = fGeometryService->DetHalfHeight();
-    double zmin = 0.;
-    double zmax = fGeometryService->DetLength();
+  // Add up energy deposit in TPC, stops once more than e_needed has been found
+  double LArG4FakeTriggerFilter::EnergyInTPC(const simb::MCParticle& particle, double e_needed){
 
     double e_dep = 0;
 
-    int npts = particle->NumberTrajectoryPoints();
+    auto const& trajectory = particle.Trajectory();
+    int npts = trajectory.size();
     for (int i = 1; i < npts; i++){
-      TVector3 pos(particle->Vx(i), particle->Vy(i), particle->Vz(i));
-      // Check if point is within the TPC
-      if (pos[0] >= xmin && pos[0] <= xmax && pos[1] >= ymin && pos[1] <= ymax && pos[2] >= zmin && pos[2] <= zmax){
-        e_dep += particle->E(i-1) - particle->E(i);
-      }
+      auto const& pos = trajectory.Position(i);
+      // Segments ending inside the TPC count towards the deposit
+      if (!InTPC(pos.X(), pos.Y(), pos.Z())) continue;
+      e_dep += trajectory.E(i-1) - trajectory.E(i);
+      if (e_dep > e_needed) break;
     }
 
     return e_dep;
@@ -0,0 +1,124 @@
+#include <utility>
+#include <vector>
+
+#include "art/Framework/Core/EDFilter.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Utilities/InputTag.h"
+
+#include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "lardataobj/Simulation/SimPhotons.h"
+
+namespace filt{
+
+  // Keeps events with enough detected photons inside a time window, using the
+  // per channel time histograms of SimPhotonsLite and stopping at threshold
+  class SimPhotonsLiteTimeFilter : public art::EDFilter {
+    public:
+
+      explicit SimPhotonsLiteTimeFilter(fhicl::ParameterSet const & pset);
+      virtual bool filter(art::Event& e) override;
+      void reconfigure(fhicl::ParameterSet const& pset);
+      virtual void beginJob() override;
+
+    private:
+
+      art::InputTag fSimPhotonsLiteLabel; // Label of the direct SimPhotonsLite
+      bool fUseReflectedPhotons;          // Also count the reflected photon instance
+      std::vector<std::pair<int, int>> fTimeWindows; // Accepted photon time windows [ns]
+      double fMinTotalPhotons;            // Minimum weighted number of photons to keep the event
+      double fDefaultChannelWeight;       // Weight of channels not listed in ChannelWeights
+      std::vector<std::pair<int, double>> fChannelWeightList; // (channel, weight) overrides
+
+      std::vector<double> fChannelWeights; // Weight indexed by optical channel
+
+      double ChannelWeight(int channel) const;
+      bool AddPhotons(const std::vector<sim::SimPhotonsLite>& photons, double& total) const;
+  };
+
+
+  SimPhotonsLiteTimeFilter::SimPhotonsLiteTimeFilter(fhicl::ParameterSet const & pset)
+  : EDFilter(pset)
+  {
+    this->reconfigure(pset);
+  }
+
+
+  void SimPhotonsLiteTimeFilter::reconfigure(fhicl::ParameterSet const& pset){
+
+    fSimPhotonsLiteLabel  = pset.get<art::InputTag>("SimPhotonsLiteLabel");
+    fUseReflectedPhotons  = pset.get<bool>("UseReflectedPhotons");
+    fTimeWindows          = pset.get<std::vector<std::pair<int, int>>>("TimeWindows");
+    fMinTotalPhotons      = pset.get<double>("MinTotalPhotons");
+    fDefaultChannelWeight = pset.get<double>("DefaultChannelWeight", 1.);
+    fChannelWeightList    = pset.get<std::vector<std::pair<int, double>>>("ChannelWeights", {});
+
+  }
+
+
+  void SimPhotonsLiteTimeFilter::beginJob() {
+
+    // Channel weights are fixed for the job, build the lookup once
+    geo::GeometryCore const* geometry = lar::providerFrom<geo::Geometry>();
+    fChannelWeights.assign(geometry->NOpDets(), fDefaultChannelWeight);
+    for(auto const& weight : fChannelWeightList){
+      if(weight.first < 0) continue;
+      if((size_t)weight.first >= fChannelWeights.size()) fChannelWeights.resize(weight.first + 1, fDefaultChannelWeight);
+      fChannelWeights[weight.first] = weight.second;
+    }
+
+  }
+
+
+  bool SimPhotonsLiteTimeFilter::filter(art::Event & e){
+
+    double total = 0;
+
+    auto directHandle = e.getValidHandle<std::vector<sim::SimPhotonsLite>>(fSimPhotonsLiteLabel);
+    if(AddPhotons(*directHandle, total)) return true;
+
+    if(fUseReflectedPhotons){
+      art::InputTag reflectedLabel(fSimPhotonsLiteLabel.label(), "Reflected", fSimPhotonsLiteLabel.process());
+      auto reflectedHandle = e.getValidHandle<std::vector<sim::SimPhotonsLite>>(reflectedLabel);
+      if(AddPhotons(*reflectedHandle, total)) return true;
+    }
+
+    return false;
+
+  }
+
+
+  double SimPhotonsLiteTimeFilter::ChannelWeight(int channel) const{
+    if(channel < 0 || (size_t)channel >= fChannelWeights.size()) return fDefaultChannelWeight;
+    return fChannelWeights[channel];
+  }
+
+
+  // Add the weighted photons inside the time windows to the total, returns true as soon as it passes threshold
+  bool SimPhotonsLiteTimeFilter::AddPhotons(const std::vector<sim::SimPhotonsLite>& photons, double& total) const{
+
+    for(auto const& lite : photons){
+
+      double weight = ChannelWeight(lite.OpChannel);
+      if(weight == 0) continue;
+
+      auto const& timeMap = lite.DetectedPhotons;
+      for(auto const& window : fTimeWindows){
+        // Photon times are the map keys so only the window needs to be visited
+        for(auto it = timeMap.lower_bound(window.first); it != timeMap.end() && it->first <= window.second; ++it){
+          total += weight * it->second;
+        }
+        if(total >= fMinTotalPhotons) return true;
+      }
+    }
+
+    return false;
+
+  }
+
+
+  DEFINE_ART_MODULE(SimPhotonsLiteTimeFilter)
+
+}
@@ -344,6 +344,45 @@ void HitAnalysisAlg::fillHistograms(const HitVec& hitVec) const
     return;
 }
     
+// Adds the histograms of another instance, which must have been set up the same way
+void HitAnalysisAlg::merge(const HitAnalysisAlg& other)
+{
+    for(size_t idx = 0; idx < 3; idx++)
+    {
+        fHitsByWire[idx]->Add(other.fHitsByWire[idx].get());
+        fDriftTimes[idx]->Add(other.fDriftTimes[idx].get());
+        fHitsByTime[idx]->Add(other.fHitsByTime[idx].get());
+        fPulseHeight[idx]->Add(other.fPulseHeight[idx].get());
+        fPulseHeightSingle[idx]->Add(other.fPulseHeightSingle[idx].get());
+        fPulseHeightMulti[idx]->Add(other.fPulseHeightMulti[idx].get());
+        fChi2DOF[idx]->Add(other.fChi2DOF[idx].get());
+        fNumDegFree[idx]->Add(other.fNumDegFree[idx].get());
+        fChi2DOFSingle[idx]->Add(other.fChi2DOFSingle[idx].get());
+        fHitMult[idx]->Add(other.fHitMult[idx].get());
+        fHitCharge[idx]->Add(other.fHitCharge[idx].get());
+        fFitWidth[idx]->Add(other.fFitWidth[idx].get());
+        fHitSumADC[idx]->Add(other.fHitSumADC[idx].get());
+        fNDFVsChi2[idx]->Add(other.fNDFVsChi2[idx].get());
+        fPulseHVsWidth[idx]->Add(other.fPulseHVsWidth[idx].get());
+        fPulseHVsCharge[idx]->Add(other.fPulseHVsCharge[idx].get());
+        fPulseHVsHitNo[idx]->Add(other.fPulseHVsHitNo[idx].get());
+        fChargeVsHitNo[idx]->Add(other.fChargeVsHitNo[idx].get());
+        fChargeVsHitNoS[idx]->Add(other.fChargeVsHitNoS[idx].get());
+        fSPHvsIdx[idx]->Add(other.fSPHvsIdx[idx].get());
+        fSWidVsIdx[idx]->Add(other.fSWidVsIdx[idx].get());
+        f1PPHvsWid[idx]->Add(other.f1PPHvsWid[idx].get());
+        fSPPHvsWid[idx]->Add(other.fSPPHvsWid[idx].get());
+        fSOPHvsWid[idx]->Add(other.fSOPHvsWid[idx].get());
+        fPHRatVsIdx[idx]->Add(other.fPHRatVsIdx[idx].get());
+    }
+    
+    fBadWPulseHeight->Add(other.fBadWPulseHeight.get());
+    fBadWPulseHVsWidth->Add(other.fBadWPulseHVsWidth.get());
+    fBadWHitsByWire->Add(other.fBadWHitsByWire.get());
+    
+    return;
+}
+    
 // Useful for normalizing histograms
 void HitAnalysisAlg::endJob(int numEvents)
 {
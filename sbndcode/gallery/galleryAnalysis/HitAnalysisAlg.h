@@ -54,6 +54,9 @@ public:
     void fillHistograms(const TrackPlaneHitMap&) const;
     void fillHistograms(const HitVec&)           const;
     
+    // add the histograms filled by another instance (e.g. in another thread)
+    void merge(const HitAnalysisAlg&);
+    
 private:
 
     // Fcl parameters.
@@ -21,7 +21,9 @@
 #include "TVector3.h"
 
 // C/C++ standard libraries
-#include <algorithm> // std::count_if()
+#include <algorithm> // std::count_if(), std::sort(), std::unique()
+#include <functional> // std::less<>
+#include <unordered_map>
 
 
 MCAssociations::MCAssociations(fhicl::ParameterSet const& config)
@@ -125,31 +127,61 @@ void MCAssociations::doTrackHitMCAssociations(gallery::Event& event)
     // Now see how many reco hits might be associated to this particle
     art::FindMany<recob::Hit, anab::BackTrackerHitMatchingData> hitsPerMCParticle(mcParticleHandle, event, fAssnsProducerLabel);
     
-    // Make maps, we really like to make maps
-    using HitToPartVecMap = std::map<const recob::Hit*,std::set<const simb::MCParticle*>>;
-    using PartToHitVecMap = std::map<const simb::MCParticle*, std::set<const recob::Hit*>>;
+    // Everything below is indexed by position in the data product collections rather than
+    // keyed by pointer. Hits are expected to come from the hit collection; any other hit
+    // is given an index past its end so that it is still counted.
+    const recob::Hit* firstHit = hitHandle->data();
+    const size_t      numHits  = hitHandle->size();
+    std::unordered_map<const recob::Hit*, size_t> otherHitIdxMap;
     
-    HitToPartVecMap hitToPartVecMap;
-    PartToHitVecMap partToHitVecMap;
+    auto hitIndex = [&](const recob::Hit* hit) -> size_t
+    {
+        if (!std::less<const recob::Hit*>()(hit, firstHit) && std::less<const recob::Hit*>()(hit, firstHit + numHits))
+            return hit - firstHit;
+        return otherHitIdxMap.emplace(hit, numHits + otherHitIdxMap.size()).first->second;
+    };
+    
+    // Distinct (particle, hit) index pairs, sorted by particle
+    using IndexPair    = std::pair<size_t,size_t>;
+    using IndexPairVec = std::vector<IndexPair>;
+    
+    IndexPairVec partHitPairVec;
 
     // Loop through the particles
-    for(int mcIdx = 0; mcIdx < mcParticleHandle->size(); mcIdx++)
+    for(size_t mcIdx = 0; mcIdx < mcParticleHandle->size(); mcIdx++)
     {
         try
         {
-            const simb::MCParticle& mcParticle = mcParticleHandle->at(mcIdx);
+            const std::vector<const recob::Hit*>& hitsVec = hitsPerMCParticle.at(mcIdx);
             
-            std::vector<const recob::Hit*> hitsVec = hitsPerMCParticle.at(mcIdx);
-            
-            for(const auto& hit : hitsVec)
-            {
-                hitToPartVecMap[hit].insert(&mcParticle);
-                partToHitVecMap[&mcParticle].insert(hit);
-            }
+            for(const auto& hit : hitsVec) partHitPairVec.emplace_back(mcIdx, hitIndex(hit));
         }
         catch(...) {break;}
     }
     
+    std::sort(partHitPairVec.begin(), partHitPairVec.end());
+    partHitPairVec.erase(std::unique(partHitPairVec.begin(), partHitPairVec.end()), partHitPairVec.end());
+    
+    // Number of distinct hits per particle
+    std::vector<size_t> partNumHitsVec(mcParticleHandle->size(), 0);
+    
+    for(const auto& partHit : partHitPairVec) partNumHitsVec[partHit.first]++;
+    
+    // Particles per hit as a flat list sorted by hit, with offsets indexed by hit
+    const size_t numHitIdx = numHits + otherHitIdxMap.size();
+    
+    std::vector<size_t> hitPartOffsetVec(numHitIdx + 1, 0);
+    std::vector<size_t> hitPartVec(partHitPairVec.size());
+    
+    for(const auto& partHit : partHitPairVec) hitPartOffsetVec[partHit.second + 1]++;
+    for(size_t hitIdx = 0; hitIdx < numHitIdx; hitIdx++) hitPartOffsetVec[hitIdx + 1] += hitPartOffsetVec[hitIdx];
+    {
+        std::vector<size_t> fillPosVec(hitPartOffsetVec.begin(), hitPartOffsetVec.end() - 1);
+        
+        // Particles come out in increasing order for each hit since the pairs are sorted by particle
+        for(const auto& partHit : partHitPairVec) hitPartVec[fillPosVec[partHit.second]++] = partHit.first;
+    }
+    
     // In this section try looking at tracking. Eventually we want to move this out of here...
     // First step is to recover the MCTruth object vector...
     const auto& trackHandle = event.getValidHandle<std::vector<recob::Track>>(fTrackProducerLabel);
@@ -157,57 +189,63 @@ void MCAssociations::doTrackHitMCAssociations(gallery::Event& event)
     // Now see how many reco hits might be associated to this particle
     art::FindMany<recob::Hit> hitsPerTrack(trackHandle, event, fTrackProducerLabel);
     
-    // Define a mapping between tracks and associated MCParticles
-    using TrackToParticleSetMap  = std::map<const recob::Track*, std::set<const simb::MCParticle*>>;
-    using ParticleToTrackSetMap  = std::map<const simb::MCParticle*, std::set<const recob::Track*>>;
-    using ParticleToHitSetMap    = std::map<const simb::MCParticle*, std::set<const recob::Hit*>>;
-    using TrackToPartHitSetMap   = std::map<const recob::Track*, ParticleToHitSetMap>;
-    using TrackToHitsVecMap      = std::map<const recob::Track*, std::vector<const recob::Hit*>>;
-    
-    TrackToParticleSetMap  trackToParticleSetMap;
-    ParticleToTrackSetMap  particleToTrackSetMap;
+    // For each (particle, track) the number of distinct track hits the particle contributed to,
+    // sorted by particle and then track
+    struct PartTrackHits
+    {
+        size_t partIdx;
+        size_t trackIdx;
+        size_t numHits;
+    };
     
-    TrackToPartHitSetMap   trackToPartHitSetMap;
-    TrackToHitsVecMap      trackToHitsVecMap;
+    std::vector<PartTrackHits> partTrackHitsVec;
+    std::vector<size_t>        trackNumHitsVec(trackHandle->size(), 0);
+    IndexPairVec               trackPartHitPairVec;
 
     // Loop through the tracks and associate via the hits to MCParticles
-    for(int trkIdx = 0; trkIdx < trackHandle->size(); trkIdx++)
+    for(size_t trkIdx = 0; trkIdx < trackHandle->size(); trkIdx++)
     {
-        const recob::Track& track = trackHandle->at(trkIdx);
-        
-        std::vector<const recob::Hit*> hitsVec = hitsPerTrack.at(trkIdx);
+        const std::vector<const recob::Hit*>& hitsVec = hitsPerTrack.at(trkIdx);
         
-        trackToHitsVecMap[&track] = hitsVec;
+        trackNumHitsVec[trkIdx] = hitsVec.size();
         
-        ParticleToHitSetMap& particleToHitSetMap = trackToPartHitSetMap[&track];
+        trackPartHitPairVec.clear();
         
         for(const auto& hit : hitsVec)
         {
-            HitToPartVecMap::iterator partItr = hitToPartVecMap.find(hit);
+            size_t hitIdx = hitIndex(hit);
             
-            if (partItr != hitToPartVecMap.end())
-            {
-                for(const auto& particle : partItr->second)
-                {
-                    particleToHitSetMap[particle].insert(hit);
-                    trackToParticleSetMap[&track].insert(particle);
-                    particleToTrackSetMap[particle].insert(&track);
-                }
-            }
+            if (hitIdx >= numHitIdx) continue;
+            
+            for(size_t partItr = hitPartOffsetVec[hitIdx]; partItr < hitPartOffsetVec[hitIdx + 1]; partItr++)
+                trackPartHitPairVec.emplace_back(hitPartVec[partItr], hitIdx);
+        }
+        
+        std::sort(trackPartHitPairVec.begin(), trackPartHitPairVec.end());
+        trackPartHitPairVec.erase(std::unique(trackPartHitPairVec.begin(), trackPartHitPairVec.end()), trackPartHitPairVec.end());
+        
+        for(const auto& partHit : trackPartHitPairVec)
+        {
+            if (partTrackHitsVec.empty() || partTrackHitsVec.back().trackIdx != trkIdx || partTrackHitsVec.back().partIdx != partHit.first)
+                partTrackHitsVec.push_back({partHit.first, trkIdx, 0});
+            
+            partTrackHitsVec.back().numHits++;
         }
     }
     
+    std::sort(partTrackHitsVec.begin(), partTrackHitsVec.end(), [](const auto& left, const auto& right)
+        {return left.partIdx < right.partIdx || (left.partIdx == right.partIdx && left.trackIdx < right.trackIdx);});
+    
     // *****************************************************************************************
     // The bits below here should eventually be moved into their own analyzer algorithm
     // but we are in a hurry now so do it all here...
     // Ok, at this point we should be able to relate MCParticles to tracks and hits
     // Let's start by just looking at the primary particle
-    const simb::MCParticle& primaryParticle = mcParticleHandle->at(0);
-    
-    ParticleToTrackSetMap::iterator partTrackItr = particleToTrackSetMap.find(&primaryParticle);
+    const size_t            primaryIdx      = 0;
+    const simb::MCParticle& primaryParticle = mcParticleHandle->at(primaryIdx);
     
     // Define the parameters we want...
-    int   numPrimaryHitsTotal = partToHitVecMap[&primaryParticle].size();
+    int   numPrimaryHitsTotal = partNumHitsVec[primaryIdx];
     
     // If there are NO reconstructed hits associated to this particle then we don't count
     // But this should really be a check on fiducial volume I think...
@@ -221,28 +259,30 @@ void MCAssociations::doTrackHitMCAssociations(gallery::Event& event)
         
         // Here we find the best matched track to the MCParticle.
         // Nothing exciting, most hits wins sort of thing...
-        if (partTrackItr != particleToTrackSetMap.end())
+        size_t bestTrackIdx(0);
+        
+        for(const auto& partTrackHits : partTrackHitsVec)
         {
+            if (partTrackHits.partIdx != primaryIdx) break;
+            
             // Recover the longest track...
-            for(const auto& track : partTrackItr->second)
+            if (partTrackHits.numHits > size_t(numTrackHits))
             {
-                if (trackToPartHitSetMap[track][partTrackItr->first].size() > numTrackHits)
-                {
-                    bestTrack    = track;
-                    numTrackHits = trackToPartHitSetMap[track][partTrackItr->first].size();
-                }
+                bestTrack    = &trackHandle->at(partTrackHits.trackIdx);
+                bestTrackIdx = partTrackHits.trackIdx;
+                numTrackHits = partTrackHits.numHits;
             }
+        }
         
-            if (bestTrack)
-            {
-                int numPrimaryHitsMatch = numTrackHits;
-                int numTrackHitsTotal   = trackToHitsVecMap[bestTrack].size();
-        
-                completeness = float(numPrimaryHitsMatch) / float(numPrimaryHitsTotal);
-                purity       = float(numPrimaryHitsMatch) / float(numTrackHitsTotal);
-                
-                if (completeness > 0.2) efficiency = 1.;
-            }
+        if (bestTrack)
+        {
+            int numPrimaryHitsMatch = numTrackHits;
+            int numTrackHitsTotal   = trackNumHitsVec[bestTrackIdx];
+    
+            completeness = float(numPrimaryHitsMatch) / float(numPrimaryHitsTotal);
+            purity       = float(numPrimaryHitsMatch) / float(numTrackHitsTotal);
+            
+            if (completeness > 0.2) efficiency = 1.;
         }
     
         // Calculate the length of this mc particle inside the fiducial volume.
@@ -258,32 +298,32 @@ void MCAssociations::doTrackHitMCAssociations(gallery::Event& event)
         
         if (bestTrack) trackLen = length(bestTrack);
     
-        fNTracks->Fill(partToHitVecMap.size(), 1.);
-        fNHitsPerPrimary->Fill(std::log10(double(partToHitVecMap[&primaryParticle].size())), 1.);
+        fNTracks->Fill(std::count_if(partNumHitsVec.begin(), partNumHitsVec.end(), [](size_t numHits){return numHits > 0;}), 1.);
+        fNHitsPerPrimary->Fill(std::log10(double(partNumHitsVec[primaryIdx])), 1.);
         fPrimaryLength->Fill(mcTrackLen, 1.);
-        fPrimaryLenVsHits->Fill(mcTrackLen, partToHitVecMap[&primaryParticle].size(), 1.);
+        fPrimaryLenVsHits->Fill(mcTrackLen, partNumHitsVec[primaryIdx], 1.);
         
         fPrimaryRecoLength->Fill(trackLen, 1.);
         fDeltaTrackLen->Fill(trackLen-mcTrackLen, 1.);
         
         fNHitsPerReco->Fill(std::log10(numTrackHits), 1.);
-        fDeltaNHits->Fill(numTrackHits - int(partToHitVecMap[&primaryParticle].size()), 1.);
+        fDeltaNHits->Fill(numTrackHits - int(partNumHitsVec[primaryIdx]), 1.);
 
         // Loop through the particles again to histogram some secondary info...
-        for(int mcIdx = 0; mcIdx < mcParticleHandle->size(); mcIdx++)
+        for(size_t mcIdx = 0; mcIdx < mcParticleHandle->size(); mcIdx++)
         {
             try
             {
                 const simb::MCParticle& mcParticle = mcParticleHandle->at(mcIdx);
             
-                if (!partToHitVecMap[&mcParticle].empty())
+                if (partNumHitsVec[mcIdx] > 0)
                 {
                     // Calculate the length of this mc particle inside the fiducial volume.
                     double secTrackLen = length(mcParticle, xOffset, mcstart, mcend, mcstartmom, mcendmom);
                 
-                    fNHitsPerTrack->Fill(partToHitVecMap[&mcParticle].size(), 1.);
+                    fNHitsPerTrack->Fill(partNumHitsVec[mcIdx], 1.);
                     fTrackLength->Fill(secTrackLen, 1.);
-                    fTrackLenVsHits->Fill(secTrackLen, partToHitVecMap[&mcParticle].size(), 1.);
+                    fTrackLenVsHits->Fill(secTrackLen, partNumHitsVec[mcIdx], 1.);
                 }
             }
             catch(...) {break;}
@@ -316,6 +356,39 @@ void MCAssociations::doTrackHitMCAssociations(gallery::Event& event)
     return;
 } // MCAssociations::processTracks()
 
+void MCAssociations::merge(const MCAssociations& other)
+{
+    if (fNTracks && other.fNTracks)
+    {
+        fNTracks->Add(other.fNTracks.get());
+        fNHitsPerTrack->Add(other.fNHitsPerTrack.get());
+        fTrackLength->Add(other.fTrackLength.get());
+        fTrackLenVsHits->Add(other.fTrackLenVsHits.get());
+        fNHitsPerPrimary->Add(other.fNHitsPerPrimary.get());
+        fPrimaryLength->Add(other.fPrimaryLength.get());
+        fPrimaryLenVsHits->Add(other.fPrimaryLenVsHits.get());
+        fPrimaryEfficiency->Add(other.fPrimaryEfficiency.get());
+        fPrimaryCompleteness->Add(other.fPrimaryCompleteness.get());
+        fPrimaryPurity->Add(other.fPrimaryPurity.get());
+        fPrimaryEffVsHits->Add(other.fPrimaryEffVsHits.get());
+        fPrimaryCompVsHits->Add(other.fPrimaryCompVsHits.get());
+        fPrimaryPurityVsHits->Add(other.fPrimaryPurityVsHits.get());
+        fPrimaryEffVsMom->Add(other.fPrimaryEffVsMom.get());
+        fPrimaryCompVsMom->Add(other.fPrimaryCompVsMom.get());
+        fPrimaryPurityVsMom->Add(other.fPrimaryPurityVsMom.get());
+        fPrimaryEffVsLen->Add(other.fPrimaryEffVsLen.get());
+        fPrimaryCompVsLen->Add(other.fPrimaryCompVsLen.get());
+        fPrimaryPurityVsLen->Add(other.fPrimaryPurityVsLen.get());
+        fPrimaryEffVsLogHits->Add(other.fPrimaryEffVsLogHits.get());
+        fPrimaryCompVsLogHits->Add(other.fPrimaryCompVsLogHits.get());
+        fPrimaryPurityVsLogHits->Add(other.fPrimaryPurityVsLogHits.get());
+        fPrimaryRecoLength->Add(other.fPrimaryRecoLength.get());
+        fDeltaTrackLen->Add(other.fDeltaTrackLen.get());
+        fNHitsPerReco->Add(other.fNHitsPerReco.get());
+        fDeltaNHits->Add(other.fDeltaNHits.get());
+    }
+} // MCAssociations::merge()
+
 void MCAssociations::finish()
 {
     if (fNTracks)
@@ -54,6 +54,9 @@ public:
   
     void doTrackHitMCAssociations(gallery::Event&);
   
+    /// Adds the histograms filled by another instance (e.g. in another thread)
+    void merge(const MCAssociations&);
+  
     void finish();
     
 private:
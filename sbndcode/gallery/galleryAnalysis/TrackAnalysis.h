@@ -56,6 +56,9 @@ class TrackAnalysis {
   
   void processTracks(std::vector<recob::Track> const& tracks);
   
+  /// Adds the histograms filled by `other` (e.g. by another thread) to ours.
+  void merge(TrackAnalysis const& other);
+  
   void finish();
   
 }; // class TrackAnalysis
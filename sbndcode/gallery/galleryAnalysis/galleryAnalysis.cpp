@@ -10,6 +10,11 @@
  * To jump into the action, look for `SERVICE PROVIDER SETUP` and
  * `SINGLE EVENT PROCESSING` tags in the source code.
  * 
+ * If the `analysis.threads` configuration parameter is larger than 1, the
+ * input files are split among that many threads, each one with its own
+ * `gallery::Event` and its own copy of the analysis objects; their histograms
+ * are merged in input file order at the end of the job.
+ * 
  * The approach for loading services is the lowest level LArSoft provides.
  * An higher level one is to use `testing::TesterEnvironment` as in some service
  * provider unit tests (e.g., `geo::GeometryCore` and `detinfo::LArProperties`).
@@ -51,12 +56,17 @@
 
 // ROOT
 #include "TFile.h"
+#include "TMemFile.h"
+#include "TROOT.h" // ROOT::EnableThreadSafety()
 
 // C/C++ standard libraries
 #include <string>
 #include <vector>
 #include <memory> // std::make_unique()
 #include <iostream> // std::cerr
+#include <thread>
+#include <exception> // std::exception_ptr
+#include <algorithm> // std::min()
 
 
 #if !defined(__CLING__)
@@ -66,6 +76,156 @@
 #include <iostream> // std::cerr
 #endif // !__CLING__
 
+/**
+ * @brief All the analysis objects processing each event.
+ * 
+ * The parallel driver creates one of these per thread, and merges them into
+ * the one owned by the main thread at the end.
+ */
+struct EventAnalyses {
+  
+  TrackAnalysis trackAnalysis;
+  HitAnalysis::HitAnalysisAlg hitAnalysisAlg;
+  MCAssociations mcAssociations;
+  
+  art::InputTag trackTag;
+  art::InputTag hitsTag;
+  
+  int numEvents = 0;
+  
+  EventAnalyses(
+    fhicl::ParameterSet const& analysisConfig,
+    geo::GeometryCore const& geom, detinfo::DetectorProperties const& detp,
+    TDirectory* outDir
+    )
+    : trackAnalysis(analysisConfig.get<fhicl::ParameterSet>("trackAnalysis"))
+    , hitAnalysisAlg(analysisConfig.get<fhicl::ParameterSet>("hitAnalysisAlg"))
+    , mcAssociations(analysisConfig.get<fhicl::ParameterSet>("mcAssociations"))
+    , trackTag(analysisConfig.get<art::InputTag>("tracks"))
+    , hitsTag(analysisConfig.get<art::InputTag>("hits"))
+    {
+      trackAnalysis.setup(geom, outDir);
+      trackAnalysis.prepare();
+      
+      hitAnalysisAlg.setup(geom, detp, outDir);
+      
+      mcAssociations.setup(geom, detp, outDir);
+      mcAssociations.prepare();
+    }
+  
+  void processEvent(gallery::Event& event)
+    {
+      // *************************************************************************
+      // ***  SINGLE EVENT PROCESSING BEGIN  *************************************
+      // *************************************************************************
+  
+      mf::LogVerbatim("galleryAnalysis") << "This is event " << event.fileEntry() << "-" << event.eventEntry();
+  
+      trackAnalysis.processTracks(*(event.getValidHandle<std::vector<recob::Track>>(trackTag)));
+      
+      hitAnalysisAlg.fillHistograms(*(event.getValidHandle<std::vector<recob::Hit>>(hitsTag)));
+      
+      mcAssociations.doTrackHitMCAssociations(event);
+  
+      numEvents++;
+  
+      // *************************************************************************
+      // ***  SINGLE EVENT PROCESSING END    *************************************
+      // *************************************************************************
+    }
+  
+  void merge(EventAnalyses const& other)
+    {
+      trackAnalysis.merge(other.trackAnalysis);
+      hitAnalysisAlg.merge(other.hitAnalysisAlg);
+      mcAssociations.merge(other.mcAssociations);
+      numEvents += other.numEvents;
+    }
+  
+  void finish()
+    {
+      trackAnalysis.finish();
+      mcAssociations.finish();
+      
+      hitAnalysisAlg.endJob(numEvents);
+    }
+  
+}; // struct EventAnalyses
+
+
+/// Splits the files in `nParts` contiguous blocks of (almost) equal size.
+std::vector<std::vector<std::string>> partitionInputFiles
+  (std::vector<std::string> const& files, unsigned int nParts)
+{
+  std::vector<std::vector<std::string>> parts(nParts);
+  std::size_t begin = 0;
+  for (unsigned int iPart = 0; iPart < nParts; ++iPart) {
+    std::size_t const end = (files.size() * (iPart + 1)) / nParts;
+    parts[iPart].assign(files.begin() + begin, files.begin() + end);
+    begin = end;
+  }
+  return parts;
+} // partitionInputFiles()
+
+
+/**
+ * @brief Processes all the events with `nThreads` threads.
+ * @param analyses the analysis objects the results are merged into
+ * @param inputFiles the full list of input files
+ * @param nThreads the number of worker threads
+ * @param makeAnalyses creates a new `EventAnalyses` writing into a directory
+ * 
+ * Each thread reads a contiguous block of input files with its own
+ * `gallery::Event` and its own `EventAnalyses`, whose histograms live in a
+ * private in-memory file. The results of the threads are merged into
+ * `analyses` in input file order, so that the result does not depend on the
+ * scheduling of the threads.
+ */
+template <typename MakeAnalyses>
+void processEventsInParallel(
+  EventAnalyses& analyses,
+  std::vector<std::string> const& inputFiles, unsigned int nThreads,
+  MakeAnalyses makeAnalyses
+) {
+  
+  ROOT::EnableThreadSafety();
+  
+  auto const fileBlocks = partitionInputFiles(inputFiles, nThreads);
+  
+  // the in-memory file must outlive the analyses whose histograms it holds
+  struct Worker {
+    std::unique_ptr<TMemFile> histFile;
+    std::unique_ptr<EventAnalyses> analyses;
+    std::exception_ptr error;
+  };
+  std::vector<Worker> workers(nThreads);
+  
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < nThreads; ++iThread) {
+    threads.emplace_back([&, iThread](){
+      Worker& worker = workers[iThread];
+      try {
+        std::string const fileName
+          = "galleryAnalysisThread" + std::to_string(iThread) + ".root";
+        worker.histFile = std::make_unique<TMemFile>(fileName.c_str(), "RECREATE");
+        worker.analyses = makeAnalyses(worker.histFile.get());
+        for (gallery::Event event(fileBlocks[iThread]); !event.atEnd(); event.next())
+          worker.analyses->processEvent(event);
+      }
+      catch (...) { worker.error = std::current_exception(); }
+    });
+  } // for threads
+  
+  for (auto& thread: threads) thread.join();
+  
+  for (auto const& worker: workers) {
+    if (worker.error) std::rethrow_exception(worker.error);
+    analyses.merge(*worker.analyses);
+  }
+  
+} // processEventsInParallel()
+
+
 /**
  * @brief Runs the analysis macro.
  * @param configFile path to the FHiCL configuration to be used for the services
@@ -119,8 +279,8 @@ int galleryAnalysis(std::string const& configFile, std::vector<std::string> cons
     /*
      * other parameters
      */
-    art::InputTag trackTag = analysisConfig.get<art::InputTag>("tracks");
-    art::InputTag hitsTag  = analysisConfig.get<art::InputTag>("hits");
+    unsigned int const nThreads = std::min<std::size_t>
+      (analysisConfig.get<unsigned int>("threads", 1U), allInputFiles.size());
   
     /*
      * preparation of histogram output file
@@ -134,53 +294,27 @@ int galleryAnalysis(std::string const& configFile, std::vector<std::string> cons
     }
   
     /*
-     * preparation of the algorithm class
+     * preparation of the algorithm classes
      */
-    TrackAnalysis trackAnalysis(analysisConfig.get<fhicl::ParameterSet>("trackAnalysis"));
-  
-    trackAnalysis.setup(*geom, pHistFile.get());
-    trackAnalysis.prepare();
-    
-    HitAnalysis::HitAnalysisAlg hitAnalysisAlg(analysisConfig.get<fhicl::ParameterSet>("hitAnalysisAlg"));
-    
-    hitAnalysisAlg.setup(*geom, *detp, pHistFile.get());
-    
-    MCAssociations mcAssociations(analysisConfig.get<fhicl::ParameterSet>("mcAssociations"));
+    auto makeAnalyses = [&](TDirectory* outDir)
+      { return std::make_unique<EventAnalyses>(analysisConfig, *geom, *detp, outDir); };
     
-    mcAssociations.setup(*geom, *detp, pHistFile.get());
-    mcAssociations.prepare();
-    
-    int numEvents(0);
+    std::unique_ptr<EventAnalyses> analyses = makeAnalyses(pHistFile.get());
   
     /*
      * the event loop
      */
-    for (gallery::Event event(allInputFiles); !event.atEnd(); event.next())
+    if (nThreads > 1)
     {
-        // *************************************************************************
-        // ***  SINGLE EVENT PROCESSING BEGIN  *************************************
-        // *************************************************************************
-    
-        mf::LogVerbatim("galleryAnalysis") << "This is event " << event.fileEntry() << "-" << event.eventEntry();
-    
-        trackAnalysis.processTracks(*(event.getValidHandle<std::vector<recob::Track>>(trackTag)));
-        
-        hitAnalysisAlg.fillHistograms(*(event.getValidHandle<std::vector<recob::Hit>>(hitsTag)));
-        
-        mcAssociations.doTrackHitMCAssociations(event);
-
-        numEvents++;
-    
-        // *************************************************************************
-        // ***  SINGLE EVENT PROCESSING END    *************************************
-        // *************************************************************************
-    
-    } // for
+        processEventsInParallel(*analyses, allInputFiles, nThreads, makeAnalyses);
+    }
+    else
+    {
+        for (gallery::Event event(allInputFiles); !event.atEnd(); event.next())
+            analyses->processEvent(event);
+    }
   
-    trackAnalysis.finish();
-    mcAssociations.finish();
-    
-    hitAnalysisAlg.endJob(numEvents);
+    analyses->finish();
   
     return 0;
 } // galleryAnalysis()